@@ -0,0 +1,92 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// note! replaces the global allocation functions so benchmarks can detect heap allocations
+
+// === HELPERS ===
+
+namespace {
+std::atomic<size_t> COUNT;
+
+void *allocate(size_t size) {
+  COUNT.fetch_add(1, std::memory_order_relaxed);
+  if (auto result = std::malloc(size == 0 ? 1 : size); result != nullptr) {
+    return result;
+  }
+  throw std::bad_alloc{};
+}
+
+// note! aligned_alloc requires the size to be a multiple of the alignment
+void *allocate(size_t size, std::align_val_t alignment) {
+  COUNT.fetch_add(1, std::memory_order_relaxed);
+  auto alignment_2 = static_cast<size_t>(alignment);
+  auto size_2 = ((size == 0 ? 1 : size) + alignment_2 - 1) / alignment_2 * alignment_2;
+  if (auto result = std::aligned_alloc(alignment_2, size_2); result != nullptr) {
+    return result;
+  }
+  throw std::bad_alloc{};
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+namespace allocations {
+
+size_t count() {
+  return COUNT.load(std::memory_order_relaxed);
+}
+
+}  // namespace allocations
+
+void *operator new(size_t size) {
+  return allocate(size);
+}
+
+void *operator new[](size_t size) {
+  return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  return allocate(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return allocate(size, alignment);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
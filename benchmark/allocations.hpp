@@ -0,0 +1,12 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <cstddef>
+
+namespace allocations {
+
+// note! number of heap allocations (global operator new) since process start
+size_t count();
+
+}  // namespace allocations
@@ -2,8 +2,22 @@
 
 #include <benchmark/benchmark.h>
 
+#include <fmt/format.h>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "roq/algo/matcher/basic_simple.hpp"
 #include "roq/algo/matcher/factory.hpp"
 
+#include "allocations.hpp"
+
 using namespace std::literals;
 
 using namespace roq;
@@ -22,6 +36,7 @@ void BM_tools_Simple_add(benchmark::State &state) {
     void operator()(Event<OrderAck> const &) override {}
     void operator()(Event<OrderUpdate> const &) override {}
     void operator()(Event<TradeUpdate> const &) override {}
+    void operator()(Event<CancelAllOrdersAck> const &) override {}
     void operator()(Event<MassQuoteAck> const &) override {}
     void operator()(Event<CancelQuotesAck> const &) override {}
   } dispatcher;
@@ -40,3 +55,857 @@ void BM_tools_Simple_add(benchmark::State &state) {
 }
 
 BENCHMARK(BM_tools_Simple_add);
+
+// === CONSTANTS ===
+
+namespace {
+auto const TICK_SIZE = 0.1;
+
+// note! initial best bid/ask (ticks)
+int64_t const BID = 10000;
+int64_t const ASK = BID + 2;
+
+// note! max number of latency samples (ring buffer, most recent samples are kept)
+size_t const MAX_SAMPLES = 1 << 20;
+
+// note! length (before closing) of the synthetic event stream used for replay
+size_t const REPLAY_LENGTH = 1 << 14;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+struct Dispatcher final : public Matcher::Dispatcher {
+  using Matcher::Dispatcher::operator();  // note! Sweep and Batch (static dispatch)
+
+  void operator()(Event<ReferenceData> const &) override {}
+  void operator()(Event<MarketStatus> const &) override {}
+  void operator()(Event<TopOfBook> const &) override {}
+  void operator()(Event<MarketByPriceUpdate> const &) override {}
+  void operator()(Event<MarketByOrderUpdate> const &) override {}
+  void operator()(Event<TradeSummary> const &) override {}
+  void operator()(Event<StatisticsUpdate> const &) override {}
+  void operator()(Event<OrderAck> const &) override {}
+  void operator()(Event<OrderUpdate> const &) override {}
+  void operator()(Event<TradeUpdate> const &event) override { fills += std::size(event.value.fills); }
+  void operator()(Event<CancelAllOrdersAck> const &) override {}
+  void operator()(Event<MassQuoteAck> const &) override {}
+  void operator()(Event<CancelQuotesAck> const &) override {}
+
+  size_t fills = {};
+};
+
+// note! fixed number of slots (re-used) so the cache itself doesn't allocate in steady state
+struct FixedOrderCache final : public OrderCache {
+  explicit FixedOrderCache(size_t size) : orders_(size) {}
+
+  cache::Order &operator()(CreateOrder const &create_order) {
+    auto &result = orders_[create_order.order_id % std::size(orders_)];
+    result = cache::Order{create_order};
+    return result;
+  }
+
+  cache::Order &operator()(uint64_t order_id) {
+    auto result = get_order_helper(order_id);
+    assert(result);
+    return *result;
+  }
+
+  bool is_working(uint64_t order_id) {
+    auto order = get_order_helper(order_id);
+    return order && order->order_status == OrderStatus::WORKING;
+  }
+
+  uint64_t get_next_trade_id() override { return ++next_trade_id_; }
+
+ protected:
+  cache::Order *get_order_helper(uint64_t order_id) override {
+    auto &result = orders_[order_id % std::size(orders_)];
+    return result.order_id == order_id ? &result : nullptr;
+  }
+
+ private:
+  std::vector<cache::Order> orders_;
+  uint64_t next_trade_id_ = {};
+};
+
+// note! per-event latency (steady clock around the matcher call, clock overhead is included)
+struct Latency final {
+  Latency() : samples_(MAX_SAMPLES) {}
+
+  template <typename Callback>
+  void operator()(Callback callback) {
+    auto start = std::chrono::steady_clock::now();
+    callback();
+    auto stop = std::chrono::steady_clock::now();
+    samples_[count_++ % std::size(samples_)] = stop - start;
+  }
+
+  void report(benchmark::State &state, std::string_view const &prefix = {}) const {
+    auto size = std::min(count_, std::size(samples_));
+    if (size == 0) {
+      return;
+    }
+    std::vector<std::chrono::nanoseconds> samples{std::begin(samples_), std::begin(samples_) + size};
+    std::sort(std::begin(samples), std::end(samples));
+    auto percentile = [&](double value) {
+      auto index = std::min(static_cast<size_t>(value * static_cast<double>(size)), size - 1);
+      return static_cast<double>(samples[index].count());
+    };
+    auto sum = std::chrono::nanoseconds{};
+    for (auto &item : samples) {
+      sum += item;
+    }
+    auto counter = [&](auto name, auto value) { state.counters[fmt::format("{}{}"sv, prefix, name)] = value; };
+    counter("mean"sv, static_cast<double>(sum.count()) / static_cast<double>(size));
+    counter("p50"sv, percentile(0.5));
+    counter("p99"sv, percentile(0.99));
+    counter("p99.9"sv, percentile(0.999));
+  }
+
+ private:
+  std::vector<std::chrono::nanoseconds> samples_;
+  size_t count_ = {};
+};
+
+// note! either the Matcher interface or a header-only matcher (static dispatch)
+template <typename MatcherType = Matcher>
+struct Helper final {
+  Helper(MatcherType &matcher, FixedOrderCache &order_cache, MarketDataSource market_data_source = MarketDataSource::TOP_OF_BOOK)
+      : matcher_{matcher}, order_cache_{order_cache}, market_data_source_{market_data_source} {}
+
+  // note! latency is only measured when set
+  void set(Latency *latency) { latency_ = latency; }
+
+  void reference_data(double tick_size) {
+    tick_size_ = tick_size;
+    auto reference_data = ReferenceData{
+        .stream_id = {},
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .description = {},
+        .security_type = {},
+        .external_security_id = {},
+        .cfi_code = {},
+        .base_currency = {},
+        .quote_currency = {},
+        .settlement_currency = {},
+        .margin_currency = {},
+        .commission_currency = {},
+        .tick_size = tick_size,
+        .tick_size_steps = {},
+        .multiplier = NaN,
+        .min_notional = NaN,
+        .min_trade_vol = 1.0,
+        .max_trade_vol = NaN,
+        .trade_vol_step_size = NaN,
+        .option_type = {},
+        .strike_currency = {},
+        .strike_price = NaN,
+        .underlying = {},
+        .time_zone = {},
+        .issue_date = {},
+        .settlement_date = {},
+        .expiry_datetime = {},
+        .expiry_datetime_utc = {},
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+        .discard = false,
+    };
+    dispatch(reference_data);
+  }
+
+  void top_of_book(double bid_price, double ask_price, double quantity = 1.0) {
+    auto top_of_book = TopOfBook{
+        .stream_id = {},
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .layer{
+            .bid_price = bid_price,
+            .bid_quantity = quantity,
+            .ask_price = ask_price,
+            .ask_quantity = quantity,
+        },
+        .update_type = UpdateType::INCREMENTAL,
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+    };
+    dispatch(top_of_book);
+  }
+
+  // note! moves best bid/ask (ticks) using the configured market data source (incremental, single level per side)
+  void market(int64_t bid, int64_t ask, double quantity = 1.0) {
+    switch (market_data_source_) {
+      using enum MarketDataSource;
+      case TOP_OF_BOOK:
+        top_of_book(to_price(bid), to_price(ask), quantity);
+        break;
+      case MARKET_BY_PRICE:
+        market_by_price(bid, ask, quantity);
+        break;
+      case MARKET_BY_ORDER:
+        market_by_order(bid, ask, quantity);
+        break;
+    }
+    bid_ = bid;
+    ask_ = ask;
+  }
+
+  void trade_summary(Side side, int64_t price, double quantity) {
+    auto trade = Trade{
+        .side = side,
+        .price = to_price(price),
+        .quantity = quantity,
+        .trade_id = {},
+    };
+    auto trade_summary = TradeSummary{
+        .stream_id = {},
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .trades = {&trade, 1},
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+    };
+    dispatch(trade_summary);
+  }
+
+  void create_order(Side side, double price) { create_order(++next_order_id_, side, price); }
+
+  void create_order(uint64_t order_id, Side side, double price, TimeInForce time_in_force = TimeInForce::GTC) {
+    auto create_order = CreateOrder{
+        .account = ACCOUNT,
+        .order_id = order_id,
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .side = side,
+        .position_effect = {},
+        .margin_mode = {},
+        .quantity_type = {},
+        .max_show_quantity = NaN,
+        .order_type = OrderType::LIMIT,
+        .time_in_force = time_in_force,
+        .execution_instructions = {},
+        .request_template = {},
+        .quantity = 1.0,
+        .price = price,
+        .stop_price = NaN,
+        .leverage = NaN,
+        .routing_id = {},
+        .strategy_id = {},
+        .release_time_utc = {},
+    };
+    dispatch(create_order);
+  }
+
+  void create_order(uint64_t order_id, Side side, int64_t price, TimeInForce time_in_force = TimeInForce::GTC) {
+    create_order(order_id, side, to_price(price), time_in_force);
+  }
+
+  void modify_order(uint64_t order_id, int64_t price) {
+    auto modify_order = ModifyOrder{
+        .account = ACCOUNT,
+        .order_id = order_id,
+        .request_template = {},
+        .quantity = NaN,
+        .price = to_price(price),
+        .routing_id = {},
+        .version = {},
+        .conditional_on_version = {},
+        .release_time_utc = {},
+    };
+    dispatch(modify_order);
+  }
+
+  void cancel_order(uint64_t order_id) {
+    auto cancel_order = CancelOrder{
+        .account = ACCOUNT,
+        .order_id = order_id,
+        .request_template = {},
+        .routing_id = {},
+        .version = {},
+        .conditional_on_version = {},
+        .release_time_utc = {},
+    };
+    dispatch(cancel_order);
+  }
+
+  void cancel_all_orders() {
+    auto cancel_all_orders = CancelAllOrders{
+        .account = ACCOUNT,
+        .order_id = {},
+        .exchange = {},
+        .symbol = {},
+        .strategy_id = {},
+        .side = {},
+    };
+    dispatch(cancel_all_orders);
+  }
+
+ protected:
+  static constexpr auto const ACCOUNT = "A1"sv;
+  static constexpr auto const EXCHANGE = "deribit"sv;
+  static constexpr auto const SYMBOL = "BTC-PERPETUAL"sv;
+
+  double to_price(int64_t ticks) const { return static_cast<double>(ticks) * tick_size_; }
+
+  void market_by_price(int64_t bid, int64_t ask, double quantity) {
+    std::array<MBPUpdate, 2> bids, asks;
+    auto helper = [&](auto &result, auto previous, auto price) -> std::span<MBPUpdate const> {
+      auto create = [&](auto price, auto quantity) {
+        return MBPUpdate{
+            .price = to_price(price),
+            .quantity = quantity,
+            .implied_quantity = NaN,
+            .number_of_orders = {},
+            .update_action = {},
+            .price_level = {},
+        };
+      };
+      size_t size = 0;
+      if (previous && previous != price) {
+        result[size++] = create(previous, 0.0);
+      }
+      result[size++] = create(price, quantity);
+      return {std::data(result), size};
+    };
+    auto market_by_price_update = MarketByPriceUpdate{
+        .stream_id = {},
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .bids = helper(bids, bid_, bid),
+        .asks = helper(asks, ask_, ask),
+        .update_type = UpdateType::INCREMENTAL,
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+        .price_precision = {},
+        .quantity_precision = {},
+        .max_depth = {},
+        .checksum = {},
+    };
+    dispatch(market_by_price_update);
+  }
+
+  // note! one order per level, order id derived from side and price
+  void market_by_order(int64_t bid, int64_t ask, double quantity) {
+    std::array<MBOUpdate, 4> orders;
+    size_t size = 0;
+    auto helper = [&](auto side, auto previous, auto price) {
+      auto create = [&](auto price, auto quantity, auto action) {
+        auto &buffer = order_ids_[size];
+        auto length = fmt::format_to_n(std::data(buffer), std::size(buffer), "{}{}"sv, side == Side::BUY ? 'B' : 'S', price).size;
+        return MBOUpdate{
+            .price = to_price(price),
+            .quantity = quantity,
+            .priority = ++priority_,
+            .order_id = std::string_view{std::data(buffer), std::min(length, std::size(buffer))},
+            .side = side,
+            .action = action,
+            .reason = {},
+        };
+      };
+      if (previous == price) {
+        orders[size] = create(price, quantity, UpdateAction::CHANGE);
+        ++size;
+        return;
+      }
+      if (previous) {
+        orders[size] = create(previous, 0.0, UpdateAction::DELETE);
+        ++size;
+      }
+      orders[size] = create(price, quantity, UpdateAction::NEW);
+      ++size;
+    };
+    helper(Side::BUY, bid_, bid);
+    helper(Side::SELL, ask_, ask);
+    auto market_by_order_update = MarketByOrderUpdate{
+        .stream_id = {},
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .orders = {std::data(orders), size},
+        .update_type = UpdateType::INCREMENTAL,
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+        .price_precision = {},
+        .quantity_precision = {},
+        .max_depth = {},
+        .checksum = {},
+    };
+    dispatch(market_by_order_update);
+  }
+
+  template <typename T>
+  void dispatch(T const &value) {
+    auto now = ++time_;
+    auto message_info = MessageInfo{
+        .source = {},
+        .source_name = EXCHANGE,
+        .source_session_id = {},
+        .source_seqno = ++seqno_,
+        .receive_time_utc = now,
+        .receive_time = now,
+        .source_send_time = now,
+        .source_receive_time = now,
+        .origin_create_time = now,
+        .origin_create_time_utc = now,
+        .is_last = true,
+        .opaque = {},
+    };
+    Event event{message_info, value};
+    auto helper = [&]() {
+      if constexpr (std::is_same_v<T, CreateOrder>) {
+        auto &order = order_cache_(value);
+        matcher_(event, order);
+      } else if constexpr (std::is_same_v<T, ModifyOrder> || std::is_same_v<T, CancelOrder>) {
+        auto &order = order_cache_(value.order_id);
+        matcher_(event, order);
+      } else {
+        matcher_(event);
+      }
+    };
+    if (latency_) {
+      (*latency_)(helper);
+    } else {
+      helper();
+    }
+  }
+
+ private:
+  MatcherType &matcher_;
+  FixedOrderCache &order_cache_;
+  MarketDataSource const market_data_source_;
+  Latency *latency_ = nullptr;
+  double tick_size_ = NaN;
+  int64_t bid_ = {};
+  int64_t ask_ = {};
+  std::array<std::array<char, 32>, 4> order_ids_;
+  uint64_t priority_ = {};
+  uint64_t seqno_ = {};
+  std::chrono::nanoseconds time_ = {};
+  uint64_t next_order_id_ = {};
+};
+
+Config create_config(MarketDataSource market_data_source) {
+  return {
+      .source = {},
+      .exchange = "deribit"sv,
+      .symbol = "BTC-PERPETUAL"sv,
+      .market_data_source = market_data_source,
+  };
+}
+
+// note! owns everything required to drive a matcher
+struct Context final {
+  Context(Type type, MarketDataSource market_data_source, size_t max_orders)
+      : order_cache{max_orders + 1}, matcher{Factory::create(type, dispatcher, order_cache, create_config(market_data_source))},
+        helper{*matcher, order_cache, market_data_source} {
+    helper.reference_data(TICK_SIZE);
+    helper.market(BID, ASK);
+  }
+
+  // note! one passive order per level, buy orders use ids [1, depth] and sell orders use ids [depth + 1, 2 * depth]
+  void create_resting_orders(size_t depth) {
+    for (size_t i = 0; i < depth; ++i) {
+      auto offset = static_cast<int64_t>(i) + 1;
+      helper.create_order(i + 1, Side::BUY, BID - offset);
+      helper.create_order(depth + i + 1, Side::SELL, ASK + offset);
+    }
+  }
+
+  Dispatcher dispatcher;
+  FixedOrderCache order_cache;
+  std::unique_ptr<Matcher> matcher;
+  Helper<> helper;
+};
+
+// note! synthetic event stream (bounded random walk with passive order flow), closed so it can be replayed in a loop
+struct Replay final {
+  enum class Action {
+    MARKET,
+    CREATE,
+    MODIFY,
+    CANCEL,
+    TRADE,
+  };
+
+  struct Step final {
+    Action action = {};
+    uint64_t order_id = {};
+    Side side = {};
+    int64_t price = {};  // note! bid for MARKET
+  };
+
+  explicit Replay(size_t max_orders) {
+    std::mt19937_64 generator{max_orders};  // note! deterministic
+    auto random = [&](int64_t max) { return static_cast<int64_t>(generator() % static_cast<uint64_t>(max)); };
+    struct Order final {
+      uint64_t order_id = {};
+      Side side = {};
+    };
+    std::vector<Order> orders;
+    std::vector<uint64_t> order_ids;
+    for (size_t i = max_orders; i > 0; --i) {
+      order_ids.emplace_back(i);
+    }
+    auto bid = BID;
+    auto passive = [&](auto side) { return side == Side::BUY ? bid - 1 - random(32) : bid + 3 + random(32); };
+    while (std::size(steps) < REPLAY_LENGTH) {
+      auto value = random(100);
+      if (value < 40) {
+        bid = std::clamp(bid + (random(2) ? 1 : -1), BID - 64, BID + 64);
+        steps.push_back({.action = Action::MARKET, .order_id = {}, .side = {}, .price = bid});
+      } else if (value < 60) {
+        if (std::empty(order_ids)) {
+          continue;
+        }
+        auto order = Order{.order_id = order_ids.back(), .side = random(2) ? Side::BUY : Side::SELL};
+        order_ids.pop_back();
+        orders.emplace_back(order);
+        steps.push_back({.action = Action::CREATE, .order_id = order.order_id, .side = order.side, .price = passive(order.side)});
+      } else if (value < 75) {
+        if (std::empty(orders)) {
+          continue;
+        }
+        auto index = static_cast<size_t>(random(static_cast<int64_t>(std::size(orders))));
+        auto order = orders[index];
+        orders[index] = orders.back();
+        orders.pop_back();
+        order_ids.emplace_back(order.order_id);
+        steps.push_back({.action = Action::CANCEL, .order_id = order.order_id, .side = order.side, .price = {}});
+      } else if (value < 85) {
+        if (std::empty(orders)) {
+          continue;
+        }
+        auto &order = orders[static_cast<size_t>(random(static_cast<int64_t>(std::size(orders))))];
+        steps.push_back({.action = Action::MODIFY, .order_id = order.order_id, .side = order.side, .price = passive(order.side)});
+      } else {
+        auto side = random(2) ? Side::BUY : Side::SELL;
+        steps.push_back({.action = Action::TRADE, .order_id = {}, .side = side, .price = side == Side::BUY ? bid + 2 : bid});
+      }
+    }
+    // note! close the stream
+    for (auto &order : orders) {
+      steps.push_back({.action = Action::CANCEL, .order_id = order.order_id, .side = order.side, .price = {}});
+    }
+    while (bid != BID) {
+      bid += bid < BID ? 1 : -1;
+      steps.push_back({.action = Action::MARKET, .order_id = {}, .side = {}, .price = bid});
+    }
+  }
+
+  template <typename T>
+  void operator()(Helper<T> &helper) const {
+    for (auto &step : steps) {
+      switch (step.action) {
+        using enum Action;
+        case MARKET:
+          helper.market(step.price, step.price + 2);
+          break;
+        case CREATE:
+          helper.create_order(step.order_id, step.side, step.price);
+          break;
+        case MODIFY:
+          helper.modify_order(step.order_id, step.price);
+          break;
+        case CANCEL:
+          helper.cancel_order(step.order_id);
+          break;
+        case TRADE:
+          helper.trade_summary(step.side, step.price, 1.0);
+          break;
+      }
+    }
+  }
+
+  std::vector<Step> steps;
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+// note! steady-state matching loop (resting order filled by market update + aggressive order filled on arrival)
+// note! fails if any heap allocation is detected while measuring
+
+template <Type type>
+void BM_matcher_fill_no_allocation(benchmark::State &state) {
+  Dispatcher dispatcher;
+  FixedOrderCache order_cache{16};
+  auto config = matcher::Config{
+      .exchange = "deribit"sv,
+      .symbol = "BTC-PERPETUAL"sv,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = Factory::create(type, dispatcher, order_cache, config);
+  Helper helper{*matcher, order_cache};
+  helper.reference_data(0.1);
+  helper.top_of_book(100.0, 102.0);
+  auto run_once = [&]() {
+    helper.create_order(Side::BUY, 100.0);  // resting
+    helper.top_of_book(98.0, 100.0);        // maker fill
+    helper.top_of_book(100.0, 102.0);
+    helper.create_order(Side::BUY, 102.0);  // taker fill
+  };
+  // warm-up
+  for (size_t i = 0; i < 1024; ++i) {
+    run_once();
+  }
+  dispatcher.fills = {};
+  auto allocations = allocations::count();
+  for (auto _ : state) {
+    run_once();
+  }
+  if (allocations::count() != allocations) {
+    state.SkipWithError("Unexpected: heap allocation detected in steady-state matching loop");
+  }
+  state.counters["fills"] = benchmark::Counter(static_cast<double>(dispatcher.fills), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_matcher_fill_no_allocation<Type::SIMPLE>);
+BENCHMARK(BM_matcher_fill_no_allocation<Type::SIMPLE_PRICE_LADDER>);
+
+// note! same as above but for queue position (resting order filled by trade summary depleting the queue ahead + market update
+// trading through + aggressive order filled on arrival)
+
+template <Type type>
+void BM_matcher_queue_position_fill_no_allocation(benchmark::State &state) {
+  Dispatcher dispatcher;
+  FixedOrderCache order_cache{16};
+  auto config = create_config(MarketDataSource::MARKET_BY_PRICE);
+  auto matcher = Factory::create(type, dispatcher, order_cache, config);
+  Helper helper{*matcher, order_cache, MarketDataSource::MARKET_BY_PRICE};
+  helper.reference_data(TICK_SIZE);
+  helper.market(BID, ASK);
+  uint64_t order_id = {};
+  auto run_once = [&]() {
+    helper.create_order(++order_id, Side::BUY, BID);  // resting (behind the queue)
+    helper.trade_summary(Side::SELL, BID, 2.0);       // maker fill (queue depleted)
+    helper.create_order(++order_id, Side::BUY, BID);  // resting (behind the queue)
+    helper.market(BID - 2, BID);                      // maker fill (traded through)
+    helper.market(BID, ASK);
+    helper.create_order(++order_id, Side::BUY, ASK);  // taker fill
+  };
+  // warm-up
+  for (size_t i = 0; i < 1024; ++i) {
+    run_once();
+  }
+  dispatcher.fills = {};
+  auto allocations = allocations::count();
+  for (auto _ : state) {
+    run_once();
+  }
+  if (allocations::count() != allocations) {
+    state.SkipWithError("Unexpected: heap allocation detected in steady-state matching loop");
+  }
+  state.counters["fills"] = benchmark::Counter(static_cast<double>(dispatcher.fills), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_matcher_queue_position_fill_no_allocation<Type::QUEUE_POSITION_SIMPLE>);
+BENCHMARK(BM_matcher_queue_position_fill_no_allocation<Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER>);
+
+// note! the following are parameterized by type, market data source and depth (number of resting orders per side)
+
+// passive order joining the back of a resting level, then cancelled
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_create_cancel(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Context context{type, market_data_source, 2 * depth + 1};
+  context.create_resting_orders(depth);
+  auto order_id = 2 * depth + 1;
+  Latency create, cancel;
+  size_t count = 0;
+  for (auto _ : state) {
+    auto price = BID - 1 - static_cast<int64_t>(count++ % depth);
+    context.helper.set(&create);
+    context.helper.create_order(order_id, Side::BUY, price);
+    context.helper.set(&cancel);
+    context.helper.cancel_order(order_id);
+  }
+  state.SetItemsProcessed(2 * state.iterations());
+  create.report(state, "create."sv);
+  cancel.report(state, "cancel."sv);
+}
+
+// IOC taking liquidity at the touch (never resting, the book is not touched)
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_ioc(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Context context{type, market_data_source, 2 * depth + 1};
+  context.create_resting_orders(depth);
+  auto order_id = 2 * depth + 1;
+  Latency latency;
+  context.helper.set(&latency);
+  for (auto _ : state) {
+    context.helper.create_order(order_id, Side::BUY, ASK, TimeInForce::IOC);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["fills"] = benchmark::Counter(static_cast<double>(context.dispatcher.fills), benchmark::Counter::kAvgIterations);
+  latency.report(state);
+}
+
+// resting order moved between the front and the back of the book
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_modify(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Context context{type, market_data_source, 2 * depth};
+  context.create_resting_orders(depth);
+  Latency latency;
+  context.helper.set(&latency);
+  size_t count = 0;
+  for (auto _ : state) {
+    auto price = (count++ % 2) ? BID - 1 : BID - static_cast<int64_t>(depth) - 1;
+    context.helper.modify_order(1, price);
+  }
+  state.SetItemsProcessed(state.iterations());
+  latency.report(state);
+}
+
+// top of book moving through all resting buy orders (restoring the book is not measured)
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_sweep(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Context context{type, market_data_source, 2 * depth};
+  Latency latency;
+  for (auto _ : state) {
+    state.PauseTiming();
+    context.helper.set(nullptr);
+    context.helper.market(BID, ASK);
+    for (size_t i = 0; i < depth; ++i) {
+      auto order_id = i + 1;
+      if (!context.order_cache.is_working(order_id)) {
+        context.helper.create_order(order_id, Side::BUY, BID - static_cast<int64_t>(i) - 1);
+      }
+    }
+    context.helper.set(&latency);
+    state.ResumeTiming();
+    auto ask = BID - static_cast<int64_t>(depth);
+    context.helper.market(ask - 1, ask);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["fills"] = benchmark::Counter(static_cast<double>(context.dispatcher.fills), benchmark::Counter::kAvgIterations);
+  latency.report(state);
+}
+
+// all resting orders cancelled by a single request (restoring the book is not measured)
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_cancel_all(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Context context{type, market_data_source, 2 * depth};
+  Latency latency;
+  for (auto _ : state) {
+    state.PauseTiming();
+    context.helper.set(nullptr);
+    context.create_resting_orders(depth);
+    context.helper.set(&latency);
+    state.ResumeTiming();
+    context.helper.cancel_all_orders();
+  }
+  state.SetItemsProcessed(2 * static_cast<int64_t>(depth) * state.iterations());
+  latency.report(state);
+}
+
+// market data update (best bid alternating between two levels, quantity changing) without crossing resting orders
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_market_data(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Context context{type, market_data_source, 2 * depth};
+  context.create_resting_orders(depth);
+  Latency latency;
+  context.helper.set(&latency);
+  size_t count = 0;
+  for (auto _ : state) {
+    auto value = count++ % 4;
+    context.helper.market(BID + static_cast<int64_t>(value % 2), ASK, 1.0 + static_cast<double>(value / 2));
+  }
+  state.SetItemsProcessed(state.iterations());
+  latency.report(state);
+}
+
+// end-to-end replay of a synthetic event stream (depth is the max number of live orders)
+
+template <Type type, MarketDataSource market_data_source>
+void BM_matcher_replay(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Replay replay{depth};
+  Context context{type, market_data_source, depth};
+  Latency latency;
+  context.helper.set(&latency);
+  for (auto _ : state) {
+    replay(context.helper);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::size(replay.steps)));
+  state.counters["fills"] = benchmark::Counter(static_cast<double>(context.dispatcher.fills), benchmark::Counter::kAvgIterations);
+  latency.report(state);
+}
+
+// end-to-end replay (as above) using the header-only matcher directly (no virtual dispatch, compile-time market data source)
+
+template <template <typename> typename Book>
+void BM_matcher_replay_static(benchmark::State &state) {
+  auto depth = static_cast<size_t>(state.range(0));
+  Replay replay{depth};
+  Dispatcher dispatcher;
+  FixedOrderCache order_cache{depth + 1};
+  using MarketData = tools::BasicMarketData<MarketDataSource::TOP_OF_BOOK>;
+  BasicSimple<Book, Dispatcher, FixedOrderCache, MarketData> matcher{dispatcher, order_cache, create_config(MarketData::get_market_data_source())};
+  Helper helper{matcher, order_cache};
+  helper.reference_data(TICK_SIZE);
+  helper.market(BID, ASK);
+  Latency latency;
+  helper.set(&latency);
+  for (auto _ : state) {
+    replay(helper);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::size(replay.steps)));
+  state.counters["fills"] = benchmark::Counter(static_cast<double>(dispatcher.fills), benchmark::Counter::kAvgIterations);
+  latency.report(state);
+}
+
+BENCHMARK(BM_matcher_replay_static<SortedVector>)->RangeMultiplier(16)->Range(1, 1024);
+BENCHMARK(BM_matcher_replay_static<PriceLadder>)->RangeMultiplier(16)->Range(1, 1024);
+
+// === REGISTRATION ===
+
+namespace {
+template <Type type, MarketDataSource market_data_source>
+void register_benchmarks() {
+  auto helper = [](auto name, auto function) {
+    auto full_name = fmt::format("BM_matcher_{}/{}/{}"sv, name, magic_enum::enum_name(type), magic_enum::enum_name(market_data_source));
+    benchmark::RegisterBenchmark(full_name.c_str(), function)->RangeMultiplier(16)->Range(1, 1024);
+  };
+  helper("create_cancel"sv, BM_matcher_create_cancel<type, market_data_source>);
+  helper("ioc"sv, BM_matcher_ioc<type, market_data_source>);
+  helper("modify"sv, BM_matcher_modify<type, market_data_source>);
+  helper("sweep"sv, BM_matcher_sweep<type, market_data_source>);
+  helper("cancel_all"sv, BM_matcher_cancel_all<type, market_data_source>);
+  helper("market_data"sv, BM_matcher_market_data<type, market_data_source>);
+  helper("replay"sv, BM_matcher_replay<type, market_data_source>);
+}
+
+template <Type type>
+void register_benchmarks() {
+  // note! queue position requires market depth
+  if constexpr (type != Type::QUEUE_POSITION_SIMPLE && type != Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER) {
+    register_benchmarks<type, MarketDataSource::TOP_OF_BOOK>();
+  }
+  register_benchmarks<type, MarketDataSource::MARKET_BY_PRICE>();
+  register_benchmarks<type, MarketDataSource::MARKET_BY_ORDER>();
+}
+
+auto const REGISTERED = []() {
+  register_benchmarks<Type::SIMPLE>();
+  register_benchmarks<Type::SIMPLE_PRICE_LADDER>();
+  register_benchmarks<Type::QUEUE_POSITION_SIMPLE>();
+  register_benchmarks<Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER>();
+  return true;
+}();
+}  // namespace
@@ -27,6 +27,7 @@ struct ROQ_PUBLIC Parameters final {
   double min_position_0 = NaN;
   double max_position_0 = NaN;
   uint8_t publish_source = {};
+  std::chrono::nanoseconds publish_interval = {};  // custom metrics are conflated, zero means no throttling
 };
 
 }  // namespace arbitrage
@@ -47,7 +48,8 @@ struct fmt::formatter<roq::algo::arbitrage::Parameters> {
         R"(quantity_0={}, )"
         R"(min_position_0={}, )"
         R"(max_position_0={}, )"
-        R"(publish_source={})"
+        R"(publish_source={}, )"
+        R"(publish_interval={})"
         R"(}})"sv,
         value.market_data_source,
         value.max_age,
@@ -55,6 +57,7 @@ struct fmt::formatter<roq::algo::arbitrage::Parameters> {
         value.quantity_0,
         value.min_position_0,
         value.max_position_0,
-        value.publish_source);
+        value.publish_source,
+        value.publish_interval);
   }
 };
@@ -4,6 +4,9 @@
 
 #include "roq/compat.hpp"
 
+#include <cassert>
+#include <span>
+
 #include "roq/api.hpp"
 
 #include "roq/cache/order.hpp"
@@ -12,6 +15,18 @@ namespace roq {
 namespace algo {
 
 struct ROQ_PUBLIC Matcher {
+  // note! all fills caused by a single market data event
+  // note! order_updates[i] corresponds to trade_updates[i]
+  struct Sweep final {
+    std::span<OrderUpdate const> order_updates;
+    std::span<TradeUpdate const> trade_updates;
+  };
+
+  // note! all order updates caused by a single request (e.g. cancel all orders)
+  struct Batch final {
+    std::span<OrderUpdate const> order_updates;
+  };
+
   struct ROQ_PUBLIC Dispatcher {
     virtual void operator()(Event<ReferenceData> const &) = 0;
     virtual void operator()(Event<MarketStatus> const &) = 0;
@@ -26,8 +41,28 @@ struct ROQ_PUBLIC Matcher {
     virtual void operator()(Event<OrderUpdate> const &) = 0;
     virtual void operator()(Event<TradeUpdate> const &) = 0;
 
+    virtual void operator()(Event<CancelAllOrdersAck> const &) {}
+
     virtual void operator()(Event<MassQuoteAck> const &) = 0;
     virtual void operator()(Event<CancelQuotesAck> const &) = 0;
+
+    // note! default implementation will dispatch each order update and trade update individually
+    virtual void operator()(Event<Sweep> const &event) {
+      auto &[message_info, sweep] = event;
+      assert(std::size(sweep.order_updates) == std::size(sweep.trade_updates));
+      for (size_t i = 0; i < std::size(sweep.order_updates); ++i) {
+        create_event_and_dispatch(*this, message_info, sweep.order_updates[i]);
+        create_event_and_dispatch(*this, message_info, sweep.trade_updates[i]);
+      }
+    }
+
+    // note! default implementation will dispatch each order update individually
+    virtual void operator()(Event<Batch> const &event) {
+      auto &[message_info, batch] = event;
+      for (auto &order_update : batch.order_updates) {
+        create_event_and_dispatch(*this, message_info, order_update);
+      }
+    }
   };
 
   virtual ~Matcher() = default;
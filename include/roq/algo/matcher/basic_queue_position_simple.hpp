@@ -0,0 +1,1325 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "roq/utils/common.hpp"
+#include "roq/utils/update.hpp"
+
+#include "roq/algo/market_data_source.hpp"
+
+#include "roq/algo/tools/basic_market_data.hpp"
+#include "roq/algo/tools/market_data.hpp"
+#include "roq/algo/tools/time_checker.hpp"
+
+#include "roq/algo/matcher.hpp"
+
+#include "roq/algo/matcher/config.hpp"
+#include "roq/algo/matcher/depleted_levels.hpp"
+#include "roq/algo/matcher/external_trade_id_buffer.hpp"
+#include "roq/algo/matcher/price_ladder.hpp"
+#include "roq/algo/matcher/quotes.hpp"
+#include "roq/algo/matcher/sorted_vector.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// queue position simple matcher
+//
+// note! header-only, dispatcher and order cache are template parameters (static dispatch)
+// - requirements are the same as for BasicSimple
+//
+// trades => reduce
+// quote => min
+// do we need to count our quantity?
+//
+// amend (modify order)
+// - quantity down => in place (queue position and quantity ahead are kept)
+// - quantity up or price change => moved to the back of the (new) price level (quantity ahead is reset)
+//
+// aggressive (create or amend)
+// - walks the opposite side up to the limit price (one fill per level), any remaining quantity is resting
+//
+// time in force
+// - GTC => resting
+// - IOC and FOK => never resting (fast path, the book is not touched)
+// - post-only => rejected if crossing (decided from the cached top of book)
+//
+// order book (resting orders)
+// - SortedVector: O(log n) lookup, O(n) insert/erase
+// - PriceLadder: O(1) add/cancel/match-at-touch (tick indexed, degrades to SortedVector for very wide price ranges)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData = tools::MarketData>
+struct BasicQueuePositionSimple final {
+  BasicQueuePositionSimple(Dispatcher &, OrderCache &, Config const &);
+
+  BasicQueuePositionSimple(BasicQueuePositionSimple const &) = delete;
+
+  void operator()(Event<ReferenceData> const &);
+  void operator()(Event<MarketStatus> const &);
+
+  void operator()(Event<TopOfBook> const &);
+  void operator()(Event<MarketByPriceUpdate> const &);
+  void operator()(Event<MarketByOrderUpdate> const &);
+  void operator()(Event<TradeSummary> const &);
+  void operator()(Event<StatisticsUpdate> const &);
+
+  void operator()(Event<CreateOrder> const &, cache::Order &);
+  void operator()(Event<ModifyOrder> const &, cache::Order &);
+  void operator()(Event<CancelOrder> const &, cache::Order &);
+
+  void operator()(Event<CancelAllOrders> const &);
+
+  void operator()(Event<MassQuote> const &);
+  void operator()(Event<CancelQuotes> const &);
+
+ protected:
+  // market
+
+  void match_resting_orders(MessageInfo const &);
+  void update_queue_positions(Event<MarketByPriceUpdate> const &);
+  void match_resting_orders_2(Event<TradeSummary> const &);
+
+  // orders
+
+  template <typename T>
+  void dispatch_order_ack(Event<T> const &, cache::Order const &, Error, RequestStatus = {});
+
+  void dispatch_order_update(MessageInfo const &, cache::Order &);
+
+  void dispatch_trade_update(MessageInfo const &, cache::Order const &, std::span<Fill const> const &fills);
+
+  void add_to_sweep(cache::Order &, Fill const &);
+
+  void dispatch_sweep(MessageInfo const &);
+
+  void dispatch_batch(MessageInfo const &);
+
+  void dispatch_cancel_all_orders_ack(Event<CancelAllOrders> const &, Error, uint32_t number_of_affected_orders);
+
+  OrderUpdate create_order_update(cache::Order &);
+
+  TradeUpdate create_trade_update(cache::Order const &, std::span<Fill const> const &fills);
+
+  void execute_immediately(MessageInfo const &, CreateOrder const &, cache::Order &, int64_t price);
+
+  std::span<Fill const> take_liquidity(cache::Order &, double price);
+
+  bool can_fill(cache::Order const &, double price) const;
+
+  double get_best_price(Side) const;
+
+  template <typename Callback>
+  void for_each_crossed_level(Side, double price, Callback) const;
+
+  static void update_traded(cache::Order &, Fill const &);
+
+  // quotes
+
+  template <typename R, typename T>
+  void dispatch_quote_ack(Event<T> const &, Error);
+
+  void remove_quote(cache::Order const &);
+
+  // utils
+
+  bool is_instrument(std::string_view const &exchange, std::string_view const &symbol) const;
+
+  bool is_aggressive(Side, int64_t price) const;
+
+  void rescale(int64_t factor);
+
+  static bool is_priority_lost(ModifyOrder const &, cache::Order const &);
+
+  static bool is_supported(TimeInForce);
+
+  void add_order(uint64_t order_id, Side, int64_t price, double ahead);
+
+  bool remove_order(uint64_t order_id, Side);
+
+  void move_order(uint64_t order_id, Side, int64_t price, double ahead);
+
+  template <typename Callback>
+  bool get_order(uint64_t order_id, Callback);
+
+  template <typename Callback>
+  void try_match(Side, Callback);
+
+  struct Order final {
+    uint64_t order_id = {};
+    int64_t price = {};
+    double ahead = NaN;  // note! could change this to uint64_t
+  };
+
+  static void update_ahead(Order &, double quantity);
+
+  template <typename Callback>
+  void try_match_helper(Book<Order> &, int64_t price, Callback);
+
+  void deplete_queue(Book<Order> &, Side, int64_t price, double quantity);
+
+  void fill_resting_order(cache::Order &, double quantity);
+
+  template <typename T>
+  void check(Event<T> const &);
+
+ private:
+  Dispatcher &dispatcher_;
+  OrderCache &order_cache_;
+  std::string const exchange_;
+  std::string const symbol_;
+  MarketData market_data_;
+  // note! internal (integer) is in units of tick_size, external (floating point) is the real price
+  struct {
+    struct {
+      int64_t bid_price = std::numeric_limits<int64_t>::min();
+      int64_t ask_price = std::numeric_limits<int64_t>::max();
+    } internal;
+    struct {
+      double bid_price = NaN;
+      double ask_price = NaN;
+    } external;
+  } top_of_book_;
+  // note! priority is preserved by first ordering by price (internal) and then by time (FIFO within a price level)
+  Book<Order> buy_orders_{Side::BUY};
+  Book<Order> sell_orders_{Side::SELL};
+  Quotes quotes_;
+  std::vector<uint64_t> completed_;  // note! re-used
+  ExternalTradeIdBuffer external_trade_id_;
+  DepletedLevels depleted_;
+  // note! all fills caused by a single market data event (buffers are re-used)
+  struct {
+    std::vector<Fill> fills;
+    std::vector<OrderUpdate> order_updates;
+    std::vector<TradeUpdate> trade_updates;
+  } sweep_;
+  std::vector<OrderUpdate> batch_;  // note! re-used
+  std::vector<Fill> fills_;         // note! re-used
+  // DEBUG
+  tools::TimeChecker time_checker_;
+};
+
+// === IMPLEMENTATION ===
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::BasicQueuePositionSimple(
+    Dispatcher &dispatcher, OrderCache &order_cache, Config const &config)
+    : dispatcher_{dispatcher}, order_cache_{order_cache}, exchange_{config.exchange}, symbol_{config.symbol},
+      market_data_{config.exchange, config.symbol, config.market_data_source},
+      quotes_{config.exchange, config.symbol} {
+  using namespace std::literals;
+  if (config.market_data_source == MarketDataSource::TOP_OF_BOOK) {
+    throw RuntimeError{"Unsupported: market_data_source={}"sv, config.market_data_source};
+  }
+}
+
+// note! the following handlers **must** dispatch market data and **may** potentially overlay own orders and fills
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<ReferenceData> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  if (market_data_(event)) {
+    rescale(market_data_.get_rescale_factor());
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<MarketStatus> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  market_data_(event);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<TopOfBook> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  if (market_data_(event)) {
+    match_resting_orders(event);
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<MarketByPriceUpdate> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  if (market_data_(event)) {
+    update_queue_positions(event);
+    match_resting_orders(event);
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<MarketByOrderUpdate> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  if (market_data_(event)) {
+    match_resting_orders(event);
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<TradeSummary> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  if (market_data_(event)) {
+    match_resting_orders_2(event);
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<StatisticsUpdate> const &event) {
+  check(event);
+  dispatcher_(event);  // note!
+  market_data_(event);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<CreateOrder> const &event, cache::Order &order) {
+  using namespace std::literals;
+  check(event);
+  auto &[message_info, create_order] = event;
+  auto validate = [&]() -> Error {
+    // note! simulator will already have validated the request and here we just need to validate based on what is supported here
+    if (create_order.quantity_type != QuantityType{}) {
+      return Error::INVALID_QUANTITY_TYPE;
+    }
+    if (create_order.order_type != OrderType::LIMIT) {
+      return Error::INVALID_ORDER_TYPE;
+    }
+    if (!is_supported(create_order.time_in_force)) {
+      return Error::INVALID_TIME_IN_FORCE;
+    }
+    auto post_only = create_order.execution_instructions == Mask<ExecutionInstruction>{ExecutionInstruction::PARTICIPATE_DO_NOT_INITIATE};
+    if (post_only) {
+      if (create_order.time_in_force != TimeInForce::GTC) {
+        return Error::INVALID_EXECUTION_INSTRUCTION;  // note! can never execute
+      }
+    } else if (create_order.execution_instructions != Mask<ExecutionInstruction>{}) {
+      return Error::INVALID_EXECUTION_INSTRUCTION;
+    }
+    if (!std::isnan(create_order.stop_price)) {
+      return Error::INVALID_STOP_PRICE;
+    }
+    if (post_only) {
+      // note! decided from the cached top of book (no book access)
+      auto [price, overflow] = market_data_.price_to_ticks(create_order.price);
+      if (overflow || is_aggressive(create_order.side, price)) {
+        return Error::INVALID_PRICE;
+      }
+    }
+    return {};
+  };
+  if (auto error = validate(); error != Error{}) {
+    dispatch_order_ack(event, order, error);
+  } else {
+    dispatch_order_ack(event, order, {}, RequestStatus::ACCEPTED);
+    auto [price, overflow] = market_data_.price_to_ticks(create_order.price);
+    if (overflow) [[unlikely]] {
+      log::fatal("Unexpected: overflow when converting price to internal representation"sv);
+    }
+    if (create_order.time_in_force != TimeInForce::GTC) {
+      execute_immediately(message_info, create_order, order, price);  // note! fast path (never resting)
+    } else if (is_aggressive(create_order.side, price)) {
+      order.create_time_utc = market_data_.exchange_time_utc();
+      order.remaining_quantity = create_order.quantity;
+      order.traded_quantity = 0.0;
+      order.average_traded_price = NaN;
+      auto fills = take_liquidity(order, create_order.price);
+      if (order.order_status == OrderStatus::WORKING) {
+        auto ahead = market_data_.total_quantity(create_order.side, create_order.price);
+        add_order(order.order_id, order.side, price, ahead);  // note! remaining quantity
+      }
+      dispatch_order_update(message_info, order);
+      dispatch_trade_update(message_info, order, fills);
+    } else {
+      auto ahead = market_data_.total_quantity(create_order.side, create_order.price);
+      add_order(order.order_id, order.side, price, ahead);
+      order.create_time_utc = market_data_.exchange_time_utc();
+      order.update_time_utc = market_data_.exchange_time_utc();
+      order.order_status = OrderStatus::WORKING;
+      order.remaining_quantity = create_order.quantity;
+      order.traded_quantity = 0.0;
+      order.average_traded_price = NaN;
+      order.last_traded_quantity = NaN;
+      order.last_traded_price = NaN;
+      order.last_liquidity = {};
+      dispatch_order_update(message_info, order);
+    }
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<ModifyOrder> const &event, cache::Order &order) {
+  using namespace std::literals;
+  check(event);
+  auto &[message_info, modify_order] = event;
+  auto has_price = !std::isnan(modify_order.price);
+  auto has_quantity = !std::isnan(modify_order.quantity);
+  auto has_no_effect = [&]() -> bool {
+    auto change = false;
+    change |= has_quantity && utils::compare(modify_order.quantity, order.quantity) != 0;
+    change |= has_price && utils::compare(modify_order.price, order.price) != 0;
+    return !change;
+  };
+  auto validate = [&]() -> Error {
+    if (utils::is_order_complete(order.order_status)) {
+      return Error::TOO_LATE_TO_MODIFY_OR_CANCEL;
+    }
+    if (has_no_effect()) {
+      return Error::MODIFY_HAS_NO_EFFECT;
+    }
+    if (has_quantity && utils::compare(modify_order.quantity, order.traded_quantity) <= 0) {
+      return Error::INVALID_QUANTITY;  // note! partially filled
+    }
+    return {};
+  };
+  if (auto error = validate(); error != Error{}) {
+    dispatch_order_ack(event, order, error);
+  } else {
+    auto price_2 = has_price ? modify_order.price : order.price;
+    auto [price, overflow] = market_data_.price_to_ticks(price_2);
+    if (overflow) [[unlikely]] {
+      log::fatal("Unexpected: overflow when converting price to internal representation"sv);
+    }
+    if (is_aggressive(order.side, price)) {
+      utils::update(order.quantity, modify_order.quantity);
+      utils::update(order.price, modify_order.price);
+      order.remaining_quantity = order.quantity - order.traded_quantity;
+      auto fills = take_liquidity(order, order.price);
+      if (order.order_status == OrderStatus::WORKING) {
+        auto ahead = market_data_.total_quantity(order.side, order.price);
+        move_order(order.order_id, order.side, price, ahead);  // note! remaining quantity
+      } else if (!remove_order(order.order_id, order.side)) {
+        log::fatal("Unexpected: internal error"sv);
+      }
+      dispatch_order_ack(event, order, {}, RequestStatus::ACCEPTED);
+      dispatch_order_update(message_info, order);
+      dispatch_trade_update(message_info, order, fills);
+    } else {
+      if (is_priority_lost(modify_order, order)) {
+        auto ahead = market_data_.total_quantity(order.side, price_2);
+        move_order(order.order_id, order.side, price, ahead);
+      }
+      order.update_time_utc = market_data_.exchange_time_utc();
+      utils::update(order.quantity, modify_order.quantity);
+      utils::update(order.price, modify_order.price);
+      order.remaining_quantity = order.quantity - order.traded_quantity;
+      dispatch_order_ack(event, order, {}, RequestStatus::ACCEPTED);
+      dispatch_order_update(message_info, order);
+    }
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<CancelOrder> const &event, cache::Order &order) {
+  check(event);
+  auto &[message_info, cancel_order] = event;
+  if (utils::is_order_complete(order.order_status)) {
+    dispatch_order_ack(event, order, Error::TOO_LATE_TO_MODIFY_OR_CANCEL);
+  } else {
+    if (remove_order(order.order_id, order.side)) {
+      order.update_time_utc = market_data_.exchange_time_utc();
+      order.order_status = OrderStatus::CANCELED;
+      dispatch_order_ack(event, order, {}, RequestStatus::ACCEPTED);
+    } else {
+      dispatch_order_ack(event, order, Error::TOO_LATE_TO_MODIFY_OR_CANCEL, RequestStatus::REJECTED);
+    }
+    dispatch_order_update(message_info, order);
+  }
+}
+
+// note! single pass over the resting orders (one or both sides) and all order updates are dispatched as one batch
+// note! quotes are not affected (use CancelQuotes)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<CancelAllOrders> const &event) {
+  using namespace std::literals;
+  check(event);
+  auto &[message_info, cancel_all_orders] = event;
+  if (!is_instrument(cancel_all_orders.exchange, cancel_all_orders.symbol)) [[unlikely]] {
+    dispatch_cancel_all_orders_ack(event, Error::INVALID_SYMBOL, 0);  // note! not for this instrument
+    return;
+  }
+  auto is_match = [&](auto &order) {
+    if (!std::empty(cancel_all_orders.account) && order.account != cancel_all_orders.account) {
+      return false;
+    }
+    if (cancel_all_orders.strategy_id != 0 && order.strategy_id != cancel_all_orders.strategy_id) {
+      return false;
+    }
+    return true;
+  };
+  auto callback = [&](auto &item) {
+    if (Quotes::is_quote(item.order_id)) {
+      return false;
+    }
+    auto result = false;
+    auto helper = [&](auto &order) {
+      if (!is_match(order)) {
+        return;
+      }
+      order.order_status = OrderStatus::CANCELED;
+      batch_.emplace_back(create_order_update(order));
+      result = true;
+    };
+    if (!order_cache_.get_order(item.order_id, helper)) [[unlikely]] {
+      log::fatal("Unexpected: internal error"sv);
+    }
+    return result;
+  };
+  if (cancel_all_orders.side != Side::SELL) {
+    buy_orders_.remove_if(callback);
+  }
+  if (cancel_all_orders.side != Side::BUY) {
+    sell_orders_.remove_if(callback);
+  }
+  dispatch_cancel_all_orders_ack(event, {}, static_cast<uint32_t>(std::size(batch_)));
+  dispatch_batch(message_info);
+}
+
+// note! atomic replace of the quote set (validation failure => nothing is changed)
+// note! quantity ahead is initialized from the market (same as for new orders) and is kept when only the quantity changes
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<MassQuote> const &event) {
+  check(event);
+  auto &[message_info, mass_quote] = event;
+  auto quote = quotes_.find(mass_quote);
+  if (quote == nullptr) {
+    dispatch_quote_ack<MassQuoteAck>(event, Error::INVALID_SYMBOL);  // note! not for this instrument
+    return;
+  }
+  auto validate = [&]() -> Error {
+    if (!market_data_.has_tick_size()) {
+      return Error::INVALID_PRICE;  // note! can't convert to internal representation
+    }
+    auto top_of_book = std::pair{top_of_book_.internal.bid_price, top_of_book_.internal.ask_price};
+    return quotes_.prepare(*quote, top_of_book, [this](auto price) { return market_data_.price_to_ticks(price); });
+  };
+  if (auto error = validate(); error != Error{}) {
+    dispatch_quote_ack<MassQuoteAck>(event, error);
+  } else {
+    quotes_.apply(
+        mass_quote,
+        market_data_.exchange_time_utc(),
+        [this](auto &order, auto price) {
+          auto ahead = market_data_.total_quantity(order.side, order.price);
+          add_order(order.order_id, order.side, price, ahead);
+        },
+        [this](auto &order, auto price) {
+          auto ahead = market_data_.total_quantity(order.side, order.price);
+          move_order(order.order_id, order.side, price, ahead);
+        },
+        [this](auto &order) { remove_quote(order); });
+    dispatch_quote_ack<MassQuoteAck>(event, {});
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::operator()(Event<CancelQuotes> const &event) {
+  check(event);
+  auto &[message_info, cancel_quotes] = event;
+  if (!is_instrument(cancel_quotes.exchange, cancel_quotes.symbol)) {
+    dispatch_quote_ack<CancelQuotesAck>(event, Error::INVALID_SYMBOL);  // note! not for this instrument
+    return;
+  }
+  quotes_.cancel(cancel_quotes.account, market_data_.exchange_time_utc(), [this](auto &order) { remove_quote(order); });
+  dispatch_quote_ack<CancelQuotesAck>(event, {});
+}
+
+// market
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::match_resting_orders(MessageInfo const &message_info) {
+  if (!market_data_.has_tick_size()) {
+    return;
+  }
+  auto convert = [this](auto price, auto default_value) {
+    if (!std::isnan(price)) {
+      auto [units, overflow] = market_data_.price_to_ticks(price);
+      if (!overflow) {
+        return units;
+      }
+    }
+    return default_value;
+  };
+  auto matched_order = [&](auto &order) {
+    assert(utils::compare(order.remaining_quantity, 0.0) > 0);
+    fill_resting_order(order, order.remaining_quantity);
+  };
+  depleted_.refresh([&](auto side, auto price) { return market_data_.total_quantity(side, price); });
+  // HANS check min()
+  auto bid_price = get_best_price(Side::BUY);
+  auto bid = convert(bid_price, std::numeric_limits<int64_t>::min());
+  if (utils::update(top_of_book_.internal.bid_price, bid)) {
+    top_of_book_.external.bid_price = bid_price;
+    try_match(Side::BUY, matched_order);
+  }
+  auto ask_price = get_best_price(Side::SELL);
+  auto ask = convert(ask_price, std::numeric_limits<int64_t>::max());
+  if (utils::update(top_of_book_.internal.ask_price, ask)) {
+    top_of_book_.external.ask_price = ask_price;
+    try_match(Side::SELL, matched_order);
+  }
+  dispatch_sweep(message_info);
+}
+
+// note! quote => min (there can never be more quantity ahead of us than what is currently resting at the price level)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::update_ahead(Order &order, double quantity) {
+  if (std::isnan(quantity)) {
+    return;
+  }
+  if (std::isnan(order.ahead) || quantity < order.ahead) {
+    order.ahead = quantity;
+  }
+}
+
+// note! only price levels with own orders are visited (the ladder allows for an O(1) probe)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::update_queue_positions(Event<MarketByPriceUpdate> const &event) {
+  using namespace std::literals;
+  auto &[message_info, market_by_price_update] = event;
+  if (!market_data_.has_tick_size()) {
+    return;
+  }
+  // note! a snapshot could have removed price levels => all own orders must be refreshed
+  if (market_by_price_update.update_type == UpdateType::SNAPSHOT) {
+    auto helper = [&](auto &orders) {
+      orders.for_each([&](auto &item) {
+        auto callback = [&](auto &order) { update_ahead(item, market_data_.total_quantity(order.side, order.price)); };
+        if (get_order(item.order_id, callback)) {
+        } else {
+          log::fatal("Unexpected: internal error"sv);
+        }
+      });
+    };
+    helper(buy_orders_);
+    helper(sell_orders_);
+    return;
+  }
+  auto helper = [&](auto &orders, auto &updates) {
+    if (orders.empty()) {
+      return;
+    }
+    for (auto &item : updates) {
+      auto [price, overflow] = market_data_.price_to_ticks(item.price);
+      if (overflow) [[unlikely]] {
+        continue;
+      }
+      orders.for_each(price, [&](auto &order) { update_ahead(order, item.quantity); });
+    }
+  };
+  helper(buy_orders_, market_by_price_update.bids);
+  helper(sell_orders_, market_by_price_update.asks);
+}
+
+// note! trades are grouped by (consecutive) price and side and each group will only visit the affected price levels
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::match_resting_orders_2(Event<TradeSummary> const &event) {
+  auto &[message_info, trade_summary] = event;
+  assert(!std::empty(trade_summary.trades));
+  if (!market_data_.has_tick_size()) {
+    return;
+  }
+  auto helper = [&](auto side, auto price, auto total_quantity) {
+    auto [price_2, overflow] = market_data_.price_to_ticks(price);
+    if (overflow) [[unlikely]] {
+      return;
+    }
+    // note! taker side => only resting orders on the opposite side (undefined => both)
+    if (side != Side::BUY) {
+      deplete_queue(buy_orders_, Side::BUY, price_2, total_quantity);
+    }
+    if (side != Side::SELL) {
+      deplete_queue(sell_orders_, Side::SELL, price_2, total_quantity);
+    }
+  };
+  auto side = Side{};
+  auto price = NaN;
+  auto total_quantity = 0.0;
+  for (auto &item : trade_summary.trades) {
+    if (std::isnan(price) || utils::compare(price, item.price) != 0 || side != item.side) {
+      if (utils::compare(total_quantity, 0.0) > 0) {
+        assert(!std::isnan(price));
+        helper(side, price, total_quantity);
+      }
+      side = item.side;
+      price = item.price;
+      total_quantity = 0.0;
+    }
+    total_quantity += item.quantity;
+  }
+  assert(!std::isnan(price));
+  if (utils::compare(total_quantity, 0.0) > 0) {
+    helper(side, price, total_quantity);
+  }
+  dispatch_sweep(message_info);
+}
+
+// note! trades => reduce
+// - trading through a price level => all resting orders at that price level are filled
+// - trading at a price level => quantity ahead is reduced and any excess will fill resting orders (in priority order)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::deplete_queue(Book<Order> &orders, Side side, int64_t price, double quantity) {
+  using namespace std::literals;
+  if (orders.empty()) {
+    return;
+  }
+  auto through = side == Side::BUY ? price + 1 : price - 1;
+  try_match_helper(orders, through, [&](auto &order) { fill_resting_order(order, order.remaining_quantity); });
+  auto filled_quantity = 0.0;
+  completed_.clear();
+  orders.for_each(price, [&](auto &item) {
+    auto ahead = std::isnan(item.ahead) ? 0.0 : item.ahead;
+    if (utils::compare(quantity, ahead) <= 0) {
+      item.ahead = ahead - quantity;
+      return;
+    }
+    item.ahead = 0.0;
+    auto available = quantity - ahead - filled_quantity;
+    if (utils::compare(available, 0.0) <= 0) {
+      return;
+    }
+    auto callback = [&](auto &order) {
+      auto fill_quantity = std::min(available, order.remaining_quantity);
+      filled_quantity += fill_quantity;
+      fill_resting_order(order, fill_quantity);
+      if (utils::is_order_complete(order.order_status)) {
+        completed_.emplace_back(item.order_id);
+      }
+    };
+    if (get_order(item.order_id, callback)) {
+    } else {
+      log::fatal("Unexpected: internal error"sv);
+    }
+  });
+  for (auto order_id : completed_) {
+    if (!orders.remove(order_id)) [[unlikely]] {
+      log::fatal("Unexpected: internal error"sv);
+    }
+  }
+}
+
+// note! maker fill, could be partial
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::fill_resting_order(cache::Order &order, double quantity) {
+  assert(utils::compare(quantity, 0.0) > 0);
+  assert(utils::compare(quantity, order.remaining_quantity) <= 0);
+  auto external_trade_id = external_trade_id_(order_cache_.get_next_trade_id());
+  auto fill = Fill{
+      .exchange_time_utc = market_data_.exchange_time_utc(),
+      .external_trade_id = external_trade_id,
+      .quantity = quantity,
+      .price = order.price,
+      .liquidity = Liquidity::MAKER,
+      .commission_amount = NaN,
+      .commission_currency = {},
+      .base_amount = NaN,
+      .quote_amount = NaN,
+      .profit_loss_amount = NaN,
+  };
+  auto remaining_quantity = order.remaining_quantity - fill.quantity;
+  order.update_time_utc = market_data_.exchange_time_utc();
+  if (utils::compare(remaining_quantity, 0.0) > 0) {
+    order.order_status = OrderStatus::WORKING;
+    order.remaining_quantity = remaining_quantity;
+  } else {
+    order.order_status = OrderStatus::COMPLETED;
+    order.remaining_quantity = 0.0;
+  }
+  update_traded(order, fill);
+  add_to_sweep(order, fill);
+}
+
+// orders
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename T>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_order_ack(
+    Event<T> const &event, cache::Order const &order, Error error, RequestStatus request_status) {
+  auto &[message_info, value] = event;
+  auto get_request_status = [&]() {
+    if (request_status != RequestStatus{}) {
+      return request_status;
+    }
+    if (error != Error{}) {
+      return RequestStatus::REJECTED;
+    }
+    return RequestStatus::ACCEPTED;
+  };
+  auto get_text = [&]() -> std::string_view {
+    if (error != Error{}) {
+      return magic_enum::enum_name(error);
+    }
+    return {};
+  };
+  auto order_ack = OrderAck{
+      .account = order.account,
+      .order_id = order.order_id,
+      .exchange = order.exchange,
+      .symbol = order.symbol,
+      .side = order.side,
+      .position_effect = order.position_effect,
+      .margin_mode = order.margin_mode,
+      .quantity_type = order.quantity_type,
+      .request_type = utils::get_request_type<decltype(value)>(),
+      .origin = Origin::EXCHANGE,
+      .request_status = get_request_status(),
+      .error = error,
+      .text = get_text(),
+      .request_id = {},
+      .external_account = {},
+      .external_order_id = {},
+      .client_order_id = {},
+      .quantity = order.quantity,
+      .price = order.price,
+      .stop_price = order.stop_price,
+      .leverage = order.leverage,
+      .routing_id = {},
+      .version = utils::get_version(value),
+      .risk_exposure = NaN,
+      .risk_exposure_change = NaN,
+      .traded_quantity = order.traded_quantity,
+      .round_trip_latency = {},
+      .user = {},
+  };
+  create_event_and_dispatch(dispatcher_, message_info, order_ack);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_order_update(MessageInfo const &message_info, cache::Order &order) {
+  auto order_update = create_order_update(order);
+  create_event_and_dispatch(dispatcher_, message_info, order_update);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_trade_update(
+    MessageInfo const &message_info, cache::Order const &order, std::span<Fill const> const &fills) {
+  if (std::empty(fills)) {
+    return;
+  }
+  auto trade_update = create_trade_update(order, fills);
+  create_event_and_dispatch(dispatcher_, message_info, trade_update);
+}
+
+// note! fills are buffered (re-used) and the trade updates will only reference them once all fills have been collected
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::add_to_sweep(cache::Order &order, Fill const &fill) {
+  sweep_.fills.emplace_back(fill);
+  sweep_.order_updates.emplace_back(create_order_update(order));
+  sweep_.trade_updates.emplace_back(create_trade_update(order, {}));
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_sweep(MessageInfo const &message_info) {
+  if (std::empty(sweep_.fills)) {
+    return;
+  }
+  assert(std::size(sweep_.order_updates) == std::size(sweep_.fills));
+  assert(std::size(sweep_.trade_updates) == std::size(sweep_.fills));
+  for (size_t i = 0; i < std::size(sweep_.fills); ++i) {
+    sweep_.trade_updates[i].fills = {&sweep_.fills[i], 1};
+  }
+  auto sweep = Matcher::Sweep{
+      .order_updates = sweep_.order_updates,
+      .trade_updates = sweep_.trade_updates,
+  };
+  create_event_and_dispatch(dispatcher_, message_info, sweep);
+  sweep_.fills.clear();
+  sweep_.order_updates.clear();
+  sweep_.trade_updates.clear();
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_batch(MessageInfo const &message_info) {
+  if (std::empty(batch_)) {
+    return;
+  }
+  auto batch = Matcher::Batch{
+      .order_updates = batch_,
+  };
+  create_event_and_dispatch(dispatcher_, message_info, batch);
+  batch_.clear();
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_cancel_all_orders_ack(
+    Event<CancelAllOrders> const &event, Error error, uint32_t number_of_affected_orders) {
+  auto &[message_info, cancel_all_orders] = event;
+  auto get_text = [&]() -> std::string_view {
+    if (error != Error{}) {
+      return magic_enum::enum_name(error);
+    }
+    return {};
+  };
+  // note! rejected => echo the request
+  auto cancel_all_orders_ack = CancelAllOrdersAck{
+      .account = cancel_all_orders.account,
+      .order_id = cancel_all_orders.order_id,
+      .exchange = error != Error{} ? std::string_view{cancel_all_orders.exchange} : std::string_view{exchange_},
+      .symbol = error != Error{} ? std::string_view{cancel_all_orders.symbol} : std::string_view{symbol_},
+      .side = cancel_all_orders.side,
+      .origin = Origin::EXCHANGE,
+      .request_status = error != Error{} ? RequestStatus::REJECTED : RequestStatus::ACCEPTED,
+      .error = error,
+      .text = get_text(),
+      .number_of_affected_orders = number_of_affected_orders,
+      .strategy_id = cancel_all_orders.strategy_id,
+  };
+  create_event_and_dispatch(dispatcher_, message_info, cancel_all_orders_ack);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+OrderUpdate BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::create_order_update(cache::Order &order) {
+  if (order.create_time_utc.count() == 0) {
+    order.create_time_utc = market_data_.exchange_time_utc();  // XXX FIXME TODO this is strategy create time (not exchange time)
+  }
+  order.update_time_utc = market_data_.exchange_time_utc();  // XXX FIXME TODO this is strategy receive time (not exchange time)
+  auto order_update = static_cast<OrderUpdate>(order);
+  order_update.sending_time_utc = market_data_.exchange_time_utc();
+  order_update.update_type = UpdateType::INCREMENTAL;
+  return order_update;
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+TradeUpdate BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::create_trade_update(
+    cache::Order const &order, std::span<Fill const> const &fills) {
+  return {
+      .account = order.account,
+      .order_id = order.order_id,
+      .exchange = order.exchange,
+      .symbol = order.symbol,
+      .side = order.side,
+      .position_effect = order.position_effect,
+      .margin_mode = order.margin_mode,
+      .quantity_type = order.quantity_type,
+      .create_time_utc = market_data_.exchange_time_utc(),  // XXX FIXME TODO this is strategy receive time (not exchange time)
+      .update_time_utc = market_data_.exchange_time_utc(),  // XXX FIXME TODO this is strategy receive time (not exchange time)
+      .external_account = {},
+      .external_order_id = {},
+      .client_order_id = {},
+      .fills = fills,
+      .routing_id = {},
+      .update_type = UpdateType::INCREMENTAL,
+      .user = {},
+  };
+}
+
+// note! taker
+// - displayed liquidity is consumed (best first, single pass) up to the limit price and any remaining quantity will be resting
+// note! own fills do not update the market data, consumed liquidity is instead tracked as depleted (see DepletedLevels)
+// - the same liquidity can not be taken again, nor fill the remaining (resting) quantity as maker, until the price level is updated
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+std::span<Fill const> BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::take_liquidity(cache::Order &order, double price) {
+  fills_.clear();
+  auto remaining_quantity = order.remaining_quantity;
+  auto side = order.side == Side::BUY ? Side::SELL : Side::BUY;
+  for_each_crossed_level(order.side, price, [&](auto level_price, auto level_quantity) {
+    auto quantity = std::min(remaining_quantity, depleted_.get_available(side, level_price, level_quantity));
+    if (utils::compare(quantity, 0.0) > 0) {
+      depleted_.add(side, level_price, level_quantity, quantity);
+      auto external_trade_id = external_trade_id_(order_cache_.get_next_trade_id());
+      fills_.push_back({
+          .exchange_time_utc = market_data_.exchange_time_utc(),
+          .external_trade_id = external_trade_id,
+          .quantity = quantity,
+          .price = level_price,
+          .liquidity = Liquidity::TAKER,
+          .commission_amount = NaN,
+          .commission_currency = {},
+          .base_amount = NaN,
+          .quote_amount = NaN,
+          .profit_loss_amount = NaN,
+      });
+      remaining_quantity -= quantity;
+    }
+    return utils::compare(remaining_quantity, 0.0) > 0;
+  });
+  order.update_time_utc = market_data_.exchange_time_utc();
+  for (auto &fill : fills_) {
+    update_traded(order, fill);
+  }
+  if (utils::compare(remaining_quantity, 0.0) > 0) {
+    order.order_status = OrderStatus::WORKING;
+    order.remaining_quantity = remaining_quantity;
+  } else {
+    order.order_status = OrderStatus::COMPLETED;
+    order.remaining_quantity = 0.0;
+  }
+  return fills_;
+}
+
+// note! IOC and FOK
+// - never resting (any remaining quantity is canceled)
+// - FOK => all or nothing (available liquidity is checked before anything is filled)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::execute_immediately(
+    MessageInfo const &message_info, CreateOrder const &create_order, cache::Order &order, int64_t price) {
+  order.create_time_utc = market_data_.exchange_time_utc();
+  order.update_time_utc = market_data_.exchange_time_utc();
+  order.order_status = OrderStatus::CANCELED;
+  order.remaining_quantity = create_order.quantity;
+  order.traded_quantity = 0.0;
+  order.average_traded_price = NaN;
+  order.last_traded_quantity = NaN;
+  order.last_traded_price = NaN;
+  order.last_liquidity = {};
+  auto fills = std::span<Fill const>{};
+  if (is_aggressive(create_order.side, price)) {
+    if (create_order.time_in_force != TimeInForce::FOK || can_fill(order, create_order.price)) {
+      fills = take_liquidity(order, create_order.price);
+      if (order.order_status == OrderStatus::WORKING) {
+        order.order_status = OrderStatus::CANCELED;
+      }
+    }
+  }
+  dispatch_order_update(message_info, order);
+  dispatch_trade_update(message_info, order, fills);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::can_fill(cache::Order const &order, double price) const {
+  auto side = order.side == Side::BUY ? Side::SELL : Side::BUY;
+  auto quantity = 0.0;
+  for_each_crossed_level(order.side, price, [&](auto level_price, auto level_quantity) {
+    quantity += depleted_.get_available(side, level_price, level_quantity);
+    return utils::compare(quantity, order.remaining_quantity) < 0;
+  });
+  return utils::compare(quantity, order.remaining_quantity) >= 0;
+}
+
+// note! best price level with available liquidity (skips price levels depleted by own fills)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+double BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::get_best_price(Side side) const {
+  auto &top_of_book = market_data_.top_of_book();
+  auto result = side == Side::BUY ? top_of_book.bid_price : top_of_book.ask_price;
+  if (depleted_.empty()) {
+    return result;
+  }
+  result = NaN;
+  market_data_.for_each_level(side, [&](auto price, auto quantity) {
+    if (utils::compare(depleted_.get_available(side, price, quantity), 0.0) > 0) {
+      result = price;
+      return false;
+    }
+    return true;
+  });
+  return result;
+}
+
+// note! opposite side (best first) for as long as the limit price is crossed
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename Callback>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::for_each_crossed_level(Side side, double price, Callback callback) const {
+  auto is_buy = side == Side::BUY;
+  market_data_.for_each_level(is_buy ? Side::SELL : Side::BUY, [&](auto level_price, auto level_quantity) {
+    auto compare = utils::compare(level_price, price);
+    if (is_buy ? compare > 0 : compare < 0) {
+      return false;
+    }
+    return callback(level_price, level_quantity);
+  });
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::update_traded(cache::Order &order, Fill const &fill) {
+  auto traded_quantity = order.traded_quantity + fill.quantity;
+  if (utils::compare(order.traded_quantity, 0.0) > 0) {
+    order.average_traded_price = (order.average_traded_price * order.traded_quantity + fill.price * fill.quantity) / traded_quantity;
+  } else {
+    order.average_traded_price = fill.price;
+  }
+  order.traded_quantity = traded_quantity;
+  order.last_traded_quantity = fill.quantity;
+  order.last_traded_price = fill.price;
+  order.last_liquidity = fill.liquidity;
+}
+
+// quotes
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename R, typename T>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::dispatch_quote_ack(Event<T> const &event, Error error) {
+  auto &[message_info, value] = event;
+  auto get_text = [&]() -> std::string_view {
+    if (error != Error{}) {
+      return magic_enum::enum_name(error);
+    }
+    return {};
+  };
+  auto quote_ack = R{
+      .account = value.account,
+      .quote_id = value.quote_id,
+      .exchange = quotes_.get_exchange(),
+      .symbol = quotes_.get_symbol(),
+      .origin = Origin::EXCHANGE,
+      .request_status = error != Error{} ? RequestStatus::REJECTED : RequestStatus::ACCEPTED,
+      .error = error,
+      .text = get_text(),
+  };
+  create_event_and_dispatch(dispatcher_, message_info, quote_ack);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::remove_quote(cache::Order const &order) {
+  using namespace std::literals;
+  if (!remove_order(order.order_id, order.side)) [[unlikely]] {
+    log::fatal("Unexpected: internal error"sv);
+  }
+}
+
+// utils
+
+// note! empty => any
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::is_instrument(std::string_view const &exchange, std::string_view const &symbol) const {
+  return (std::empty(exchange) || exchange == exchange_) && (std::empty(symbol) || symbol == symbol_);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::is_aggressive(Side side, int64_t price) const {
+  using namespace std::literals;
+  switch (side) {
+    using enum Side;
+    [[unlikely]] case UNDEFINED:
+      assert(false);
+      break;
+    case BUY:
+      return price >= top_of_book_.internal.ask_price;
+    case SELL:
+      return price <= top_of_book_.internal.bid_price;
+  }
+  log::fatal("Unexpected"sv);
+}
+
+// note! price change or quantity up
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::is_priority_lost(ModifyOrder const &modify_order, cache::Order const &order) {
+  if (!std::isnan(modify_order.price) && utils::compare(modify_order.price, order.price) != 0) {
+    return true;
+  }
+  return !std::isnan(modify_order.quantity) && utils::compare(modify_order.quantity, order.quantity) > 0;
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::is_supported(TimeInForce time_in_force) {
+  switch (time_in_force) {
+    using enum TimeInForce;
+    case GTC:
+    case IOC:
+    case FOK:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+// note! tick size change => all internal prices (books and top of book) are multiplied by the same factor (external prices are unchanged)
+// - factor zero => the new tick size is not a divisor and internal prices are instead re-derived from external prices
+// - resting orders are rounded passively (buy down, sell up) if their price is no longer a multiple of the tick size
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::rescale(int64_t factor) {
+  using namespace std::literals;
+  if (factor == 1) {
+    return;
+  }
+  if (factor == 0) {
+    auto tick_size = market_data_.get_tick_size();
+    auto price_to_ticks = [&](Side side, double price) {
+      auto [result, overflow] = market_data_.price_to_ticks(price);
+      if (overflow) [[unlikely]] {
+        log::fatal("Unexpected: overflow when converting price to internal representation"sv);
+      }
+      auto compare = utils::compare(static_cast<double>(result) * tick_size, price);
+      if (side == Side::BUY && compare > 0) {
+        --result;
+      } else if (side == Side::SELL && compare < 0) {
+        ++result;
+      }
+      return result;
+    };
+    auto helper = [&](auto &price, auto external, auto undefined) {
+      if (price != undefined) {
+        price = market_data_.price_to_ticks(external).first;  // note! market prices are expected to be multiples of the tick size
+      }
+    };
+    helper(top_of_book_.internal.bid_price, top_of_book_.external.bid_price, std::numeric_limits<int64_t>::min());
+    helper(top_of_book_.internal.ask_price, top_of_book_.external.ask_price, std::numeric_limits<int64_t>::max());
+    auto reprice = [&](Side side) {
+      return [this, side, &price_to_ticks](auto &item) {
+        auto result = item.price;
+        if (!get_order(item.order_id, [&](auto &order) { result = price_to_ticks(side, order.price); })) [[unlikely]] {
+          log::fatal("Unexpected: order_id={}"sv, item.order_id);
+        }
+        return result;
+      };
+    };
+    buy_orders_.reprice(reprice(Side::BUY));
+    sell_orders_.reprice(reprice(Side::SELL));
+    return;
+  }
+  auto helper = [&](auto &price, auto undefined) {
+    if (price != undefined) {
+      price *= factor;
+    }
+  };
+  helper(top_of_book_.internal.bid_price, std::numeric_limits<int64_t>::min());
+  helper(top_of_book_.internal.ask_price, std::numeric_limits<int64_t>::max());
+  buy_orders_.rescale(factor);
+  sell_orders_.rescale(factor);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::add_order(uint64_t order_id, Side side, int64_t price, double ahead) {
+  using namespace std::literals;
+  auto order = Order{
+      .order_id = order_id,
+      .price = price,
+      .ahead = ahead,
+  };
+  switch (side) {
+    using enum Side;
+    [[unlikely]] case UNDEFINED:
+      assert(false);
+      log::fatal("Unexpected"sv);
+    case BUY:
+      buy_orders_.add(order);
+      break;
+    case SELL:
+      sell_orders_.add(order);
+      break;
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::remove_order(uint64_t order_id, Side side) {
+  using namespace std::literals;
+  switch (side) {
+    using enum Side;
+    [[unlikely]] case UNDEFINED:
+      assert(false);
+      break;
+    case BUY:
+      return buy_orders_.remove(order_id);
+    case SELL:
+      return sell_orders_.remove(order_id);
+  }
+  log::fatal("Unexpected"sv);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::move_order(uint64_t order_id, Side side, int64_t price, double ahead) {
+  using namespace std::literals;
+  auto order = Order{
+      .order_id = order_id,
+      .price = price,
+      .ahead = ahead,
+  };
+  auto helper = [&](auto &orders) {
+    if (!orders.move(order)) [[unlikely]] {
+      log::fatal("Unexpected: internal error"sv);
+    }
+  };
+  switch (side) {
+    using enum Side;
+    [[unlikely]] case UNDEFINED:
+      assert(false);
+      log::fatal("Unexpected"sv);
+    case BUY:
+      helper(buy_orders_);
+      break;
+    case SELL:
+      helper(sell_orders_);
+      break;
+  }
+}
+
+// note! quotes are internal orders (not managed by the order cache)
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename Callback>
+bool BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::get_order(uint64_t order_id, Callback callback) {
+  if (Quotes::is_quote(order_id)) {
+    return quotes_.get_order(order_id, callback);
+  }
+  return order_cache_.get_order(order_id, callback);
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename Callback>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::try_match(Side side, Callback callback) {
+  using namespace std::literals;
+  switch (side) {
+    using enum Side;
+    [[unlikely]] case UNDEFINED:
+      assert(false);
+      log::fatal("Unexpected"sv);
+    case BUY:
+      try_match_helper(sell_orders_, top_of_book_.internal.bid_price, callback);
+      break;
+    case SELL:
+      try_match_helper(buy_orders_, top_of_book_.internal.ask_price, callback);
+      break;
+  }
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename Callback>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::try_match_helper(Book<Order> &orders, int64_t price, Callback callback) {
+  using namespace std::literals;
+  orders.match(price, [&](auto &item) {
+    if (get_order(item.order_id, [&](auto &order) { callback(order); })) {
+    } else {
+      log::fatal("Unexpected: internal error"sv);
+    }
+  });
+}
+
+template <template <typename> typename Book, typename Dispatcher, typename OrderCache, typename MarketData>
+template <typename T>
+void BasicQueuePositionSimple<Book, Dispatcher, OrderCache, MarketData>::check(Event<T> const &event) {
+  using namespace std::literals;
+  auto &[message_info, value] = event;
+  log::debug(
+      "[{}:{}] receive_time={}, receive_time_utc={}, {}={}"sv,
+      message_info.source,
+      message_info.source_name,
+      message_info.receive_time,
+      message_info.receive_time_utc,
+      get_name<T>(),
+      value);
+  time_checker_(event);
+}
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
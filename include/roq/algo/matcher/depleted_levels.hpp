@@ -0,0 +1,82 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/utils/compare.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// depleted levels
+//
+// liquidity taken by own (aggressive) orders from the cached market data
+// - the market data is not updated by own fills and would otherwise offer the same liquidity again
+// - a price level is depleted until the market data next updates that price level (the quantity changes)
+//
+// note! only a few price levels (those swept since the last market data update) so a vector is used
+
+struct DepletedLevels final {
+  bool empty() const { return std::empty(levels_); }
+
+  void clear() { levels_.clear(); }
+
+  // note! level quantity less own fills (unless the price level has since been updated)
+  double get_available(Side side, double price, double quantity) const {
+    auto index = find(side, price);
+    if (index == std::size(levels_) || utils::compare(levels_[index].quantity, quantity) != 0) {
+      return quantity;
+    }
+    return levels_[index].available;
+  }
+
+  void add(Side side, double price, double quantity, double fill_quantity) {
+    auto available = get_available(side, price, quantity) - fill_quantity;
+    auto index = find(side, price);
+    if (index == std::size(levels_)) {
+      levels_.push_back({
+          .side = side,
+          .price = price,
+          .quantity = quantity,
+          .available = available,
+      });
+    } else {
+      levels_[index].quantity = quantity;
+      levels_[index].available = available;
+    }
+  }
+
+  // note! callback(side, price) must return the current level quantity (from the market data)
+  template <typename Callback>
+  void refresh(Callback callback) {
+    std::erase_if(levels_, [&](auto &item) { return utils::compare(callback(item.side, item.price), item.quantity) != 0; });
+  }
+
+ protected:
+  struct Level final {
+    Side side = {};
+    double price = NaN;
+    double quantity = NaN;  // note! level quantity when liquidity was taken
+    double available = NaN;
+  };
+
+  size_t find(Side side, double price) const {
+    for (size_t i = 0; i < std::size(levels_); ++i) {
+      if (levels_[i].side == side && utils::compare(levels_[i].price, price) == 0) {
+        return i;
+      }
+    }
+    return std::size(levels_);
+  }
+
+ private:
+  std::vector<Level> levels_;
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
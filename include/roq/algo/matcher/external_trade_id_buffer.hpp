@@ -0,0 +1,33 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// external trade id buffer
+//
+// note! formats into a fixed-capacity inline buffer (no heap allocation per fill)
+// note! the result is only valid until the next invocation
+
+struct ExternalTradeIdBuffer final {
+  std::string_view operator()(uint64_t trade_id) {
+    using namespace std::literals;
+    auto result = fmt::format_to_n(std::data(buffer_), std::size(buffer_), "trd-{}"sv, trade_id);
+    return {std::data(buffer_), std::min(result.size, std::size(buffer_))};
+  }
+
+ private:
+  std::array<char, 32> buffer_;  // note! "trd-" + max 20 digits
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,166 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/utils/container.hpp"
+
+#include "roq/algo/market_data_source.hpp"
+#include "roq/algo/matcher.hpp"
+#include "roq/algo/order_cache.hpp"
+
+#include "roq/algo/matcher/type.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// group (many instruments)
+//
+// owns one matcher per (source, exchange, symbol) and assigns dense instrument ids
+// - a matcher is created (and an id assigned) the first time ReferenceData is seen for an instrument
+// - the (interned) lookup is only required once per instrument, the id can then be used to route all events (flat table)
+// - the Matcher interface is also implemented (one lookup per event) so the group can be used as a drop-in replacement
+//
+// requests not bound to a single instrument (empty exchange and symbol) are routed to all matchers of the source
+// - cancel all orders and cancel quotes => exactly one (aggregated) ack, also if the source has no matchers
+//
+// mass quotes are routed to the matchers having a quote => exactly one (aggregated) ack
+//
+// note! matchers can't be moved so the flat table holds pointers (ids are stable)
+// note! market data for unknown instruments is dropped (ReferenceData must be seen first)
+// note! requests for unknown instruments are rejected (Error::INVALID_SYMBOL)
+
+struct ROQ_PUBLIC Group final : public Matcher {
+  static constexpr uint32_t const UNDEFINED_ID = std::numeric_limits<uint32_t>::max();
+
+  Group(Type, Matcher::Dispatcher &, OrderCache &, MarketDataSource);
+
+  Group(Group const &) = delete;
+
+  size_t size() const { return std::size(matchers_); }
+
+  // note! returns UNDEFINED_ID if not found
+  uint32_t find(uint8_t source, std::string_view const &exchange, std::string_view const &symbol) const;
+
+  // note! creates the matcher (if required) before dispatching, returns the id
+  uint32_t intern(Event<ReferenceData> const &);
+
+  void operator()(uint32_t id, Event<ReferenceData> const &);
+  void operator()(uint32_t id, Event<MarketStatus> const &);
+
+  void operator()(uint32_t id, Event<TopOfBook> const &);
+  void operator()(uint32_t id, Event<MarketByPriceUpdate> const &);
+  void operator()(uint32_t id, Event<MarketByOrderUpdate> const &);
+  void operator()(uint32_t id, Event<TradeSummary> const &);
+  void operator()(uint32_t id, Event<StatisticsUpdate> const &);
+
+  void operator()(uint32_t id, Event<CreateOrder> const &, cache::Order &);
+  void operator()(uint32_t id, Event<ModifyOrder> const &, cache::Order &);
+  void operator()(uint32_t id, Event<CancelOrder> const &, cache::Order &);
+
+  // Matcher
+
+  void operator()(Event<ReferenceData> const &) override;
+  void operator()(Event<MarketStatus> const &) override;
+
+  void operator()(Event<TopOfBook> const &) override;
+  void operator()(Event<MarketByPriceUpdate> const &) override;
+  void operator()(Event<MarketByOrderUpdate> const &) override;
+  void operator()(Event<TradeSummary> const &) override;
+  void operator()(Event<StatisticsUpdate> const &) override;
+
+  void operator()(Event<CreateOrder> const &, cache::Order &) override;
+  void operator()(Event<ModifyOrder> const &, cache::Order &) override;
+  void operator()(Event<CancelOrder> const &, cache::Order &) override;
+
+  void operator()(Event<CancelAllOrders> const &) override;
+
+  void operator()(Event<MassQuote> const &) override;
+  void operator()(Event<CancelQuotes> const &) override;
+
+ protected:
+  template <typename T, typename... Args>
+  void dispatch(uint32_t id, Event<T> const &, Args &&...);
+
+  template <typename T, typename... Args>
+  void dispatch(std::string_view const &exchange, std::string_view const &symbol, Event<T> const &, Args &&...);
+
+  template <typename T>
+  void dispatch_all(Event<T> const &);
+
+  template <typename T>
+  void dispatch_order_ack(Event<T> const &, cache::Order const &, Error);
+
+  void dispatch_cancel_all_orders_ack(Event<CancelAllOrders> const &, Error, uint32_t number_of_affected_orders);
+
+  template <typename R, typename T>
+  void dispatch_quote_ack(Event<T> const &, Error);
+
+  // note! interposed between the matchers and the dispatcher so that acks can be aggregated
+  struct Proxy final : public Matcher::Dispatcher {
+    explicit Proxy(Matcher::Dispatcher &dispatcher) : dispatcher_{dispatcher} {}
+
+    void operator()(Event<ReferenceData> const &event) override { dispatcher_(event); }
+    void operator()(Event<MarketStatus> const &event) override { dispatcher_(event); }
+
+    void operator()(Event<TopOfBook> const &event) override { dispatcher_(event); }
+    void operator()(Event<MarketByPriceUpdate> const &event) override { dispatcher_(event); }
+    void operator()(Event<MarketByOrderUpdate> const &event) override { dispatcher_(event); }
+    void operator()(Event<TradeSummary> const &event) override { dispatcher_(event); }
+    void operator()(Event<StatisticsUpdate> const &event) override { dispatcher_(event); }
+
+    void operator()(Event<OrderAck> const &event) override { dispatcher_(event); }
+    void operator()(Event<OrderUpdate> const &event) override { dispatcher_(event); }
+    void operator()(Event<TradeUpdate> const &event) override { dispatcher_(event); }
+
+    void operator()(Event<CancelAllOrdersAck> const &) override;
+
+    void operator()(Event<MassQuoteAck> const &) override;
+    void operator()(Event<CancelQuotesAck> const &) override;
+
+    void operator()(Event<Sweep> const &event) override { dispatcher_(event); }
+    void operator()(Event<Batch> const &event) override { dispatcher_(event); }
+
+    // note! only accepted acks are counted (a matcher will reject if the request is not for its instrument)
+    bool aggregate = false;
+    uint32_t number_of_affected_orders = {};
+    Error error = {};  // note! first error (quote acks)
+
+   protected:
+    void update_error(Error value) {
+      if (error == Error{}) {
+        error = value;
+      }
+    }
+
+   private:
+    Matcher::Dispatcher &dispatcher_;
+  };
+
+ private:
+  Type const type_;
+  Matcher::Dispatcher &dispatcher_;
+  Proxy proxy_;
+  OrderCache &order_cache_;
+  MarketDataSource const market_data_source_;
+  // note! source => exchange => symbol => id
+  std::vector<utils::unordered_map<std::string, utils::unordered_map<std::string, uint32_t>>> ids_;
+  // note! flat table (indexed by id)
+  std::vector<std::unique_ptr<Matcher>> matchers_;
+  std::vector<uint8_t> sources_;
+  std::vector<uint32_t> ids_buffer_;
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,473 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "roq/side.hpp"
+
+#include "roq/utils/container.hpp"
+
+#include "roq/algo/matcher/sorted_vector.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// price ladder
+//
+// resting orders (one side) indexed by tick offset from a (moving) anchor
+// - each price level is an intrusive FIFO queue of nodes
+// - nodes are allocated from a free-list (no allocation in steady state)
+// - order_id => node (handle index) allows removal without price conversion or search
+// - priority is preserved by first ordering by price (internal) and then by time (FIFO within a price level)
+//
+// add, remove and match-at-touch are O(1) (amortized)
+// - an occupancy bitmap is used to find the next best price level (64 levels per step)
+//
+// note! the ladder is re-anchored when a price falls outside the current range
+// note! degrades to a SortedVector (all orders are moved, priority is preserved) if the price range exceeds capacity
+// - the ladder is used again once all orders have been removed
+
+template <typename T>
+struct PriceLadder final {
+  explicit PriceLadder(Side side) : side_{side} {}
+
+  PriceLadder(PriceLadder const &) = delete;
+
+  bool empty() const { return overflow_ ? (*overflow_).empty() : size_ == 0; }
+  size_t size() const { return overflow_ ? (*overflow_).size() : size_; }
+
+  void add(T const &value) {
+    using namespace std::literals;
+    if (!overflow_ && !in_range(value.price) && !reanchor(value.price)) [[unlikely]] {
+      degrade();
+    }
+    if (overflow_) [[unlikely]] {
+      (*overflow_).add(value);
+      return;
+    }
+    auto [iter_2, inserted] = index_.try_emplace(value.order_id, NIL);
+    if (!inserted) [[unlikely]] {
+      log::fatal("Unexpected: internal error"sv);  // duplicate
+    }
+    auto node_id = allocate(value);
+    (*iter_2).second = node_id;
+    link(static_cast<size_t>(value.price - anchor_), node_id);
+    if (size_++ == 0 || is_better(value.price, best_)) {
+      best_ = value.price;
+    }
+  }
+
+  // note! re-uses the node (no allocation) and joins the back of the (new) price level
+  bool move(T const &value) {
+    if (overflow_) [[unlikely]] {
+      return (*overflow_).move(value);
+    }
+    auto iter = index_.find(value.order_id);
+    if (iter == std::end(index_)) {
+      return false;
+    }
+    if (!in_range(value.price) && !reanchor(value.price)) [[unlikely]] {
+      degrade();
+      return (*overflow_).move(value);
+    }
+    auto node_id = (*iter).second;
+    auto price = nodes_[node_id].value.price;
+    assert(in_range(price));
+    unlink(static_cast<size_t>(price - anchor_), node_id);
+    --size_;
+    update_best(price);
+    nodes_[node_id].value = value;
+    link(static_cast<size_t>(value.price - anchor_), node_id);
+    if (size_++ == 0 || is_better(value.price, best_)) {
+      best_ = value.price;
+    }
+    return true;
+  }
+
+  bool remove(uint64_t order_id) {
+    if (overflow_) [[unlikely]] {
+      auto result = (*overflow_).remove(order_id);
+      try_restore();
+      return result;
+    }
+    auto iter = index_.find(order_id);
+    if (iter == std::end(index_)) {
+      return false;
+    }
+    auto node_id = (*iter).second;
+    index_.erase(iter);
+    auto price = nodes_[node_id].value.price;
+    assert(in_range(price));
+    unlink(static_cast<size_t>(price - anchor_), node_id);
+    release(node_id);
+    --size_;
+    update_best(price);
+    return true;
+  }
+
+  // note! single pass over all orders, each removal is O(1) and the best price is only refreshed once
+  template <typename Callback>
+  size_t remove_if(Callback callback) {
+    if (overflow_) [[unlikely]] {
+      auto result = (*overflow_).remove_if(callback);
+      try_restore();
+      return result;
+    }
+    if (empty()) {
+      return 0;
+    }
+    removed_.clear();
+    for (auto &[order_id, node_id] : index_) {
+      if (callback(nodes_[node_id].value)) {
+        removed_.emplace_back(node_id);
+      }
+    }
+    for (auto node_id : removed_) {
+      auto &value = nodes_[node_id].value;
+      index_.erase(value.order_id);
+      unlink(static_cast<size_t>(value.price - anchor_), node_id);
+      release(node_id);
+      --size_;
+    }
+    update_best(best_);
+    return std::size(removed_);
+  }
+
+  // note! O(1) probe when there are no orders at the price level
+  // note! callback must not change price or order_id
+  template <typename Callback>
+  void for_each(int64_t price, Callback callback) {
+    if (overflow_) [[unlikely]] {
+      (*overflow_).for_each(price, callback);
+      return;
+    }
+    if (empty() || !in_range(price)) {
+      return;
+    }
+    for (auto iter = levels_[price - anchor_].head; iter != NIL; iter = nodes_[iter].next) {
+      callback(nodes_[iter].value);
+    }
+  }
+
+  // note! priority order is not guaranteed
+  template <typename Callback>
+  void for_each(Callback callback) {
+    if (overflow_) [[unlikely]] {
+      (*overflow_).for_each(callback);
+      return;
+    }
+    if (empty()) {
+      return;
+    }
+    for (auto &[order_id, node_id] : index_) {
+      callback(nodes_[node_id].value);
+    }
+  }
+
+  // note! tick size change => all prices are multiplied by a (positive) factor, priority is preserved
+  // - nodes are updated in a single pass (released nodes are included, their value is never read)
+  // - levels are spread out (and re-anchored) which is the only allocation
+  void rescale(int64_t factor) {
+    assert(factor > 0);
+    if (factor == 1) {
+      return;
+    }
+    if (overflow_) [[unlikely]] {
+      (*overflow_).rescale(factor);
+      return;
+    }
+    for (auto &node : nodes_) {
+      node.value.price *= factor;
+    }
+    if (empty()) {
+      levels_.clear();  // note! re-anchored by the next add
+      occupied_.clear();
+      return;
+    }
+    if (!reanchor(best_ * factor, factor)) [[unlikely]] {
+      degrade();  // note! levels are still indexed by the previous anchor, node prices have already been rescaled
+      return;
+    }
+    best_ *= factor;
+  }
+
+  // note! tick size change (not a multiple) => all prices are re-derived
+  // - callback(value) must return the new price and must be monotonic (priority is preserved)
+  // - orders are re-inserted (in priority order) which is the only allocation
+  template <typename Callback>
+  void reprice(Callback callback) {
+    if (overflow_) [[unlikely]] {
+      (*overflow_).reprice(callback);
+      return;
+    }
+    extract(matched_);
+    for (auto &item : matched_) {
+      item.price = callback(std::as_const(item));
+    }
+    for (auto &item : matched_) {
+      add(item);
+    }
+  }
+
+  // note! removes all orders crossing the market price (in priority order) before invoking the callback for each
+  template <typename Callback>
+  void match(int64_t price, Callback callback) {
+    if (overflow_) [[unlikely]] {
+      (*overflow_).match(price, callback);
+      try_restore();
+      return;
+    }
+    matched_.clear();
+    while (!empty() && is_crossed(best_, price)) {
+      auto index = static_cast<size_t>(best_ - anchor_);
+      while (levels_[index].head != NIL) {
+        auto node_id = levels_[index].head;
+        auto &value = nodes_[node_id].value;
+        matched_.emplace_back(value);
+        index_.erase(value.order_id);
+        unlink(index, node_id);
+        release(node_id);
+        --size_;
+      }
+      update_best(best_);
+    }
+    for (auto &item : matched_) {
+      callback(item);
+    }
+  }
+
+ protected:
+  static constexpr uint32_t const NIL = std::numeric_limits<uint32_t>::max();
+
+  static constexpr size_t const MIN_LEVELS = 256;
+  static constexpr size_t const MAX_LEVELS = size_t{1} << 20;
+
+  static constexpr size_t const BITS = 64;
+
+  struct Node final {
+    T value = {};
+    uint32_t prev = NIL;
+    uint32_t next = NIL;
+  };
+
+  struct Level final {
+    uint32_t head = NIL;
+    uint32_t tail = NIL;
+  };
+
+  bool in_range(int64_t price) const { return price >= anchor_ && (price - anchor_) < static_cast<int64_t>(std::size(levels_)); }
+
+  bool is_better(int64_t lhs, int64_t rhs) const { return side_ == Side::BUY ? lhs > rhs : lhs < rhs; }
+
+  bool is_crossed(int64_t order_price, int64_t market_price) const {
+    assert(side_ != Side::UNDEFINED);
+    return side_ == Side::BUY ? order_price >= market_price : order_price <= market_price;
+  }
+
+  // note! levels only hold node references so moving them is cheap (nodes are never moved)
+  // note! factor is used when rescaling (existing levels are spread out)
+  // note! returns false (nothing is changed) if the price range exceeds capacity
+  bool reanchor(int64_t price, int64_t factor = 1) {
+    auto min_price = price;
+    auto max_price = price;
+    if (!empty()) {
+      for (size_t i = 0; i < std::size(levels_); ++i) {
+        if (levels_[i].head != NIL) {
+          auto tmp = (anchor_ + static_cast<int64_t>(i)) * factor;
+          min_price = std::min(min_price, tmp);
+          max_price = std::max(max_price, tmp);
+        }
+      }
+    }
+    auto range = static_cast<size_t>(max_price - min_price) + 1;
+    if (range > MAX_LEVELS) [[unlikely]] {
+      return false;
+    }
+    auto size = std::min(MAX_LEVELS, std::max(MIN_LEVELS, std::max(2 * range, std::size(levels_))));
+    size = (size + BITS - 1) / BITS * BITS;
+    auto anchor = min_price - static_cast<int64_t>((size - range) / 2);
+    std::vector<Level> levels(size);
+    std::vector<uint64_t> occupied(size / BITS);
+    if (!empty()) {
+      for (size_t i = 0; i < std::size(levels_); ++i) {
+        if (levels_[i].head != NIL) {
+          auto index = static_cast<size_t>((anchor_ + static_cast<int64_t>(i)) * factor - anchor);
+          levels[index] = levels_[i];
+          occupied[index / BITS] |= uint64_t{1} << (index % BITS);
+        }
+      }
+    }
+    levels_.swap(levels);
+    occupied_.swap(occupied);
+    anchor_ = anchor;
+    return true;
+  }
+
+  // note! moves all orders (in priority order) to the sorted vector
+  void degrade() {
+    using namespace std::literals;
+    log::warn("Price range exceeds capacity (max={}) => degrading to sorted vector"sv, MAX_LEVELS);
+    extract(matched_);
+    overflow_.emplace(side_);
+    for (auto &item : matched_) {
+      (*overflow_).add(item);
+    }
+  }
+
+  // note! all orders (in priority order) are moved to result and the ladder is reset
+  void extract(std::vector<T> &result) {
+    result.clear();
+    auto append = [&](auto &level) {
+      for (auto iter = level.head; iter != NIL; iter = nodes_[iter].next) {
+        result.emplace_back(nodes_[iter].value);
+      }
+    };
+    if (side_ == Side::BUY) {
+      std::for_each(std::rbegin(levels_), std::rend(levels_), append);
+    } else {
+      std::for_each(std::begin(levels_), std::end(levels_), append);
+    }
+    levels_.clear();
+    occupied_.clear();
+    nodes_.clear();
+    free_ = NIL;
+    index_.clear();
+    size_ = 0;
+  }
+
+  void try_restore() {
+    if ((*overflow_).empty()) {
+      overflow_.reset();  // note! re-anchored by the next add
+    }
+  }
+
+  // note! finds the next occupied level towards worse prices when the best level has been emptied
+  void update_best(int64_t price) {
+    if (size_ == 0 || price != best_) {
+      return;
+    }
+    auto index = static_cast<size_t>(best_ - anchor_);
+    if (levels_[index].head != NIL) {
+      return;
+    }
+    best_ = anchor_ + static_cast<int64_t>(side_ == Side::BUY ? find_prev(index) : find_next(index));
+    assert(in_range(best_) && levels_[best_ - anchor_].head != NIL);
+  }
+
+  // note! there must be an occupied level below index
+  size_t find_prev(size_t index) const {
+    auto word = index / BITS;
+    auto bits = occupied_[word] & ((uint64_t{1} << (index % BITS)) - 1);
+    while (bits == 0) {
+      assert(word > 0);
+      bits = occupied_[--word];
+    }
+    return word * BITS + (BITS - 1) - static_cast<size_t>(std::countl_zero(bits));
+  }
+
+  // note! there must be an occupied level above index
+  size_t find_next(size_t index) const {
+    ++index;
+    auto word = index / BITS;
+    auto bits = occupied_[word] & (~uint64_t{0} << (index % BITS));
+    while (bits == 0) {
+      assert((word + 1) < std::size(occupied_));
+      bits = occupied_[++word];
+    }
+    return word * BITS + static_cast<size_t>(std::countr_zero(bits));
+  }
+
+  uint32_t allocate(T const &value) {
+    if (free_ == NIL) {
+      nodes_.emplace_back();
+      free_ = static_cast<uint32_t>(std::size(nodes_) - 1);
+    }
+    auto node_id = free_;
+    auto &node = nodes_[node_id];
+    free_ = node.next;
+    node = {
+        .value = value,
+        .prev = NIL,
+        .next = NIL,
+    };
+    return node_id;
+  }
+
+  void release(uint32_t node_id) {
+    nodes_[node_id].next = free_;
+    free_ = node_id;
+  }
+
+  // note! time priority => always appended
+  void link(size_t index, uint32_t node_id) {
+    auto &level = levels_[index];
+    if (level.head == NIL) {
+      occupied_[index / BITS] |= uint64_t{1} << (index % BITS);
+    }
+    link_after(level, level.tail, node_id);
+  }
+
+  void link_after(Level &level, uint32_t prev, uint32_t node_id) {
+    auto &node = nodes_[node_id];
+    node.prev = prev;
+    if (prev == NIL) {
+      node.next = level.head;
+      level.head = node_id;
+    } else {
+      node.next = nodes_[prev].next;
+      nodes_[prev].next = node_id;
+    }
+    if (node.next == NIL) {
+      level.tail = node_id;
+    } else {
+      nodes_[node.next].prev = node_id;
+    }
+  }
+
+  void unlink(size_t index, uint32_t node_id) {
+    auto &level = levels_[index];
+    auto &node = nodes_[node_id];
+    if (node.prev == NIL) {
+      level.head = node.next;
+    } else {
+      nodes_[node.prev].next = node.next;
+    }
+    if (node.next == NIL) {
+      level.tail = node.prev;
+    } else {
+      nodes_[node.next].prev = node.prev;
+    }
+    if (level.head == NIL) {
+      occupied_[index / BITS] &= ~(uint64_t{1} << (index % BITS));
+    }
+  }
+
+ private:
+  Side const side_;
+  int64_t anchor_ = {};
+  int64_t best_ = {};
+  size_t size_ = {};
+  std::vector<Level> levels_;
+  std::vector<uint64_t> occupied_;
+  std::vector<Node> nodes_;
+  uint32_t free_ = NIL;
+  utils::unordered_map<uint64_t, uint32_t> index_;
+  std::vector<T> matched_;
+  std::vector<uint32_t> removed_;
+  std::optional<SortedVector<T>> overflow_;
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,243 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/cache/order.hpp"
+
+#include "roq/utils/common.hpp"
+#include "roq/utils/container.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// quotes (mass quote)
+//
+// each quoted price level is an internal order (a "slot") sharing the book with regular orders
+// - slots are identified by a synthetic order_id (high bit set) so they can never collide with client order ids
+// - slots are allocated from a free-list and grouped by account (one quote set per account)
+//
+// replacing the quote set is atomic (all levels are validated before anything is changed) and slots are re-used in place
+// - same price and quantity down => quantity is updated (no book operation, priority is kept)
+// - different price or quantity up => the book node is moved (to the back of the price level)
+// - filled (no longer resting) => the book node is re-added
+// - surplus slots are removed from the book and released
+//
+// note! levels are paired by position (level i replaces level i) which is the natural mapping for a quote ladder
+// note! fills are reported through the normal sweep using the synthetic order_id
+
+struct Quotes final {
+  static constexpr uint64_t const FLAG = uint64_t{1} << 63;
+
+  static bool is_quote(uint64_t order_id) { return (order_id & FLAG) != 0; }
+
+  // note! internal (integer) is in units of tick_size, external (floating point) is the real price
+  struct Level final {
+    int64_t internal = {};
+    double price = NaN;
+    double quantity = NaN;
+  };
+
+  Quotes(std::string_view const &exchange, std::string_view const &symbol) : exchange_{exchange}, symbol_{symbol} {}
+
+  Quotes(Quotes const &) = delete;
+
+  std::string_view get_exchange() const { return exchange_; }
+  std::string_view get_symbol() const { return symbol_; }
+
+  bool is_match(std::string_view const &exchange, std::string_view const &symbol) const { return exchange == exchange_ && symbol == symbol_; }
+
+  // note! only slots still resting in the book are visible
+  template <typename Callback>
+  bool get_order(uint64_t order_id, Callback callback) {
+    auto index = order_id & ~FLAG;
+    if (!is_quote(order_id) || index >= std::size(slots_)) [[unlikely]] {
+      return false;
+    }
+    auto &order = slots_[index];
+    if (order.order_status != OrderStatus::WORKING) [[unlikely]] {
+      return false;
+    }
+    callback(order);
+    return true;
+  }
+
+  // note! the last quote for this instrument wins (if more than one)
+  Quote const *find(MassQuote const &mass_quote) const {
+    Quote const *result = nullptr;
+    for (auto &item : mass_quote.quotes) {
+      if (is_match(item.exchange, item.symbol)) {
+        result = &item;
+      }
+    }
+    return result;
+  }
+
+  // note! validates all levels before anything is changed
+  // - levels without (positive) quantity are dropped
+  // - quotes are passive and must therefore not cross the market nor each other
+  template <typename PriceToTicks>
+  Error prepare(Quote const &quote, std::pair<int64_t, int64_t> const &top_of_book, PriceToTicks price_to_ticks) {
+    auto helper = [&](auto &result, auto &levels) -> bool {
+      result.clear();
+      for (auto &item : levels) {
+        if (std::isnan(item.quantity) || utils::compare(item.quantity, 0.0) <= 0) {
+          continue;
+        }
+        if (std::isnan(item.price)) {
+          return false;
+        }
+        auto [internal, overflow] = price_to_ticks(item.price);
+        if (overflow) {
+          return false;
+        }
+        result.push_back({
+            .internal = internal,
+            .price = item.price,
+            .quantity = item.quantity,
+        });
+      }
+      return true;
+    };
+    if (!helper(bids_, quote.bids) || !helper(asks_, quote.asks)) {
+      return Error::INVALID_PRICE;
+    }
+    auto best_bid = std::numeric_limits<int64_t>::min();
+    for (auto &item : bids_) {
+      best_bid = std::max(best_bid, item.internal);
+    }
+    auto best_ask = std::numeric_limits<int64_t>::max();
+    for (auto &item : asks_) {
+      best_ask = std::min(best_ask, item.internal);
+    }
+    if (best_bid >= top_of_book.second || best_ask <= top_of_book.first || best_bid >= best_ask) {
+      return Error::INVALID_PRICE;
+    }
+    return {};
+  }
+
+  // note! must be preceded by a successful prepare
+  template <typename Add, typename Move, typename Remove>
+  void apply(MassQuote const &mass_quote, std::chrono::nanoseconds exchange_time_utc, Add add, Move move, Remove remove) {
+    auto &set = sets_[mass_quote.account];
+    auto helper = [&](auto &slots, auto side, auto &levels) {
+      auto count = std::size(slots);  // note! before any slot is added
+      auto size = std::min(count, std::size(levels));
+      for (size_t i = 0; i < size; ++i) {
+        auto &order = slots_[slots[i]];
+        auto &level = levels[i];
+        if (order.order_status != OrderStatus::WORKING) {
+          reset(order, mass_quote, level, exchange_time_utc);
+          add(order, level.internal);
+        } else if (utils::compare(order.price, level.price) != 0 || utils::compare(level.quantity, order.quantity) > 0) {
+          reset(order, mass_quote, level, exchange_time_utc);
+          move(order, level.internal);
+        } else {
+          reset(order, mass_quote, level, exchange_time_utc);
+        }
+      }
+      for (size_t i = size; i < std::size(levels); ++i) {
+        auto index = allocate();
+        auto &order = slots_[index];
+        order.account = mass_quote.account;
+        order.order_id = FLAG | index;
+        order.exchange = exchange_;
+        order.symbol = symbol_;
+        order.side = side;
+        order.create_time_utc = exchange_time_utc;
+        reset(order, mass_quote, levels[i], exchange_time_utc);
+        add(order, levels[i].internal);
+        slots.emplace_back(index);
+      }
+      for (size_t i = size; i < count; ++i) {
+        release(slots[i], exchange_time_utc, remove);
+      }
+      slots.resize(std::size(levels));
+    };
+    helper(set.bids, Side::BUY, bids_);
+    helper(set.asks, Side::SELL, asks_);
+  }
+
+  template <typename Remove>
+  void cancel(std::string_view const &account, std::chrono::nanoseconds exchange_time_utc, Remove remove) {
+    auto iter = sets_.find(account);
+    if (iter == std::end(sets_)) {
+      return;
+    }
+    auto &set = (*iter).second;
+    for (auto index : set.bids) {
+      release(index, exchange_time_utc, remove);
+    }
+    set.bids.clear();
+    for (auto index : set.asks) {
+      release(index, exchange_time_utc, remove);
+    }
+    set.asks.clear();
+  }
+
+ protected:
+  static void reset(cache::Order &order, MassQuote const &mass_quote, Level const &level, std::chrono::nanoseconds exchange_time_utc) {
+    order.quantity = level.quantity;
+    order.price = level.price;
+    order.strategy_id = mass_quote.strategy_id;
+    order.update_time_utc = exchange_time_utc;
+    order.order_status = OrderStatus::WORKING;
+    order.remaining_quantity = level.quantity;
+    order.traded_quantity = 0.0;
+    order.average_traded_price = NaN;
+    order.last_traded_quantity = NaN;
+    order.last_traded_price = NaN;
+    order.last_liquidity = {};
+  }
+
+  uint32_t allocate() {
+    if (std::empty(free_)) {
+      slots_.emplace_back();
+      return static_cast<uint32_t>(std::size(slots_) - 1);
+    }
+    auto index = free_.back();
+    free_.pop_back();
+    return index;
+  }
+
+  template <typename Remove>
+  void release(uint32_t index, std::chrono::nanoseconds exchange_time_utc, Remove remove) {
+    auto &order = slots_[index];
+    if (order.order_status == OrderStatus::WORKING) {
+      remove(order);
+      order.update_time_utc = exchange_time_utc;
+      order.order_status = OrderStatus::CANCELED;
+    }
+    free_.emplace_back(index);
+  }
+
+ private:
+  std::string const exchange_;
+  std::string const symbol_;
+  struct Set final {
+    std::vector<uint32_t> bids;
+    std::vector<uint32_t> asks;
+  };
+  utils::unordered_map<std::string, Set> sets_;
+  std::vector<cache::Order> slots_;
+  std::vector<uint32_t> free_;
+  // note! re-used
+  std::vector<Level> bids_;
+  std::vector<Level> asks_;
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,191 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "roq/side.hpp"
+
+#include "roq/utils/container.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// sorted vector
+//
+// resting orders (one side) ordered by priority
+// - first by price (internal) and then by time (FIFO within a price level)
+//
+// add and remove are O(log n) lookup + O(n) insert/erase
+//
+// note! order_id => price (handle index) allows removal without price conversion
+
+template <typename T>
+struct SortedVector final {
+  explicit SortedVector(Side side) : side_{side} {}
+
+  SortedVector(SortedVector const &) = delete;
+
+  bool empty() const { return std::empty(orders_); }
+  size_t size() const { return std::size(orders_); }
+
+  void add(T const &value) {
+    using namespace std::literals;
+    if (!index_.try_emplace(value.order_id, value.price).second) [[unlikely]] {
+      log::fatal("Unexpected: internal error"sv);  // duplicate
+    }
+    orders_.insert(upper_bound(value.price), value);
+  }
+
+  bool remove(uint64_t order_id) {
+    auto iter_2 = index_.find(order_id);
+    if (iter_2 == std::end(index_)) {
+      return false;
+    }
+    auto iter = find(order_id, (*iter_2).second);
+    index_.erase(iter_2);
+    orders_.erase(iter);
+    return true;
+  }
+
+  // note! joins the back of the (new) price level and only the orders in between are shifted (single rotate)
+  bool move(T const &value) {
+    auto iter_2 = index_.find(value.order_id);
+    if (iter_2 == std::end(index_)) {
+      return false;
+    }
+    auto iter = find(value.order_id, (*iter_2).second);
+    (*iter_2).second = value.price;
+    auto destination = upper_bound(value.price);
+    if (iter < destination) {
+      std::rotate(iter, iter + 1, destination);
+      *(destination - 1) = value;
+    } else {
+      std::rotate(destination, iter, iter + 1);
+      *destination = value;
+    }
+    return true;
+  }
+
+  // note! single pass (in-place compaction), no search per order
+  template <typename Callback>
+  size_t remove_if(Callback callback) {
+    auto iter = std::begin(orders_);
+    for (auto &item : orders_) {
+      if (callback(item)) {
+        index_.erase(item.order_id);
+      } else {
+        *(iter++) = item;
+      }
+    }
+    auto result = static_cast<size_t>(std::end(orders_) - iter);
+    orders_.erase(iter, std::end(orders_));
+    return result;
+  }
+
+  // note! binary search for the price level
+  // note! callback must not change price or order_id
+  template <typename Callback>
+  void for_each(int64_t price, Callback callback) {
+    for (auto iter = lower_bound(price); iter != std::end(orders_) && (*iter).price == price; ++iter) {
+      callback(*iter);
+    }
+  }
+
+  // note! priority order
+  template <typename Callback>
+  void for_each(Callback callback) {
+    for (auto &item : orders_) {
+      callback(item);
+    }
+  }
+
+  // note! tick size change => all prices are multiplied by a (positive) factor, priority is preserved (single pass, no re-ordering)
+  void rescale(int64_t factor) {
+    assert(factor > 0);
+    for (auto &item : orders_) {
+      item.price *= factor;
+    }
+    for (auto &[order_id, price] : index_) {
+      price *= factor;
+    }
+  }
+
+  // note! tick size change (not a multiple) => all prices are re-derived
+  // - callback(value) must return the new price and must be monotonic (single pass, no re-ordering)
+  template <typename Callback>
+  void reprice(Callback callback) {
+    for (auto &item : orders_) {
+      item.price = callback(std::as_const(item));
+      index_[item.order_id] = item.price;
+    }
+  }
+
+  // note! removes all orders crossing the market price (in priority order) before invoking the callback for each
+  template <typename Callback>
+  void match(int64_t price, Callback callback) {
+    auto iter = std::begin(orders_);
+    for (; iter != std::end(orders_); ++iter) {
+      if (!is_crossed((*iter).price, price)) {
+        break;
+      }
+    }
+    if (iter == std::begin(orders_)) {
+      return;
+    }
+    matched_.assign(std::begin(orders_), iter);
+    orders_.erase(std::begin(orders_), iter);
+    for (auto &item : matched_) {
+      index_.erase(item.order_id);
+    }
+    for (auto &item : matched_) {
+      callback(item);
+    }
+  }
+
+ protected:
+  bool is_better(int64_t lhs, int64_t rhs) const { return side_ == Side::BUY ? lhs > rhs : lhs < rhs; }
+
+  // note! first order with a worse price (the back of the price level)
+  auto upper_bound(int64_t price) {
+    return std::upper_bound(std::begin(orders_), std::end(orders_), price, [this](auto lhs, auto &rhs) { return is_better(lhs, rhs.price); });
+  }
+
+  // note! first order at the price level (or with a worse price)
+  auto lower_bound(int64_t price) {
+    return std::lower_bound(std::begin(orders_), std::end(orders_), price, [this](auto &lhs, auto rhs) { return is_better(lhs.price, rhs); });
+  }
+
+  // note! binary search for the price level and then a linear scan (time priority)
+  auto find(uint64_t order_id, int64_t price) {
+    using namespace std::literals;
+    auto iter = lower_bound(price);
+    for (; iter != std::end(orders_) && (*iter).price == price; ++iter) {
+      if ((*iter).order_id == order_id) {
+        return iter;
+      }
+    }
+    log::fatal("Unexpected: internal error"sv);
+  }
+
+  bool is_crossed(int64_t order_price, int64_t market_price) const {
+    assert(side_ != Side::UNDEFINED);
+    return side_ == Side::BUY ? order_price >= market_price : order_price <= market_price;
+  }
+
+ private:
+  Side const side_;
+  std::vector<T> orders_;
+  utils::unordered_map<uint64_t, int64_t> index_;
+  std::vector<T> matched_;
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
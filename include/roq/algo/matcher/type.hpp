@@ -9,6 +9,8 @@ namespace matcher {
 enum class Type {
   SIMPLE,
   QUEUE_POSITION_SIMPLE,
+  SIMPLE_PRICE_LADDER,                 // note! appended (persisted configurations)
+  QUEUE_POSITION_SIMPLE_PRICE_LADDER,  // note! appended (persisted configurations)
 };
 
 }  // namespace matcher
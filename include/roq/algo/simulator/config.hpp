@@ -20,6 +20,9 @@ struct ROQ_PUBLIC Config final {
   static Config parse_file(std::string_view const &path);
   static Config parse_text(std::string_view const &text);
 
+  // note! indexed by source (see Sweep::Config::order_management_latency)
+  std::vector<Latency> get_order_management_latency() const;
+
   std::vector<Source> sources;
 };
 
@@ -0,0 +1,55 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "roq/algo/matcher.hpp"
+#include "roq/algo/strategy.hpp"
+
+#include "roq/algo/simulator/sweep.hpp"
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// event log reader
+//
+// replays a recorded event log (see event log writer)
+// - the file is memory mapped (read-only) and the kernel is advised that access will be sequential
+// - events are views directly into the mapped memory (strings and native arrays are not copied)
+// - nothing is allocated per message (arrays containing views are decoded into buffers re-used by the replay)
+//
+// note! replay is const and can therefore be used concurrently (e.g. as the source for a sweep)
+// note! only market data is recorded
+
+struct ROQ_PUBLIC EventLogReader final : public Sweep::Source {
+  explicit EventLogReader(std::string_view const &path);
+
+  EventLogReader(EventLogReader const &) = delete;
+
+  ~EventLogReader() override;
+
+  // note! bytes
+  size_t size() const { return std::size(data_); }
+
+  void operator()(Sweep::Handler &) const override;
+
+  void operator()(Matcher &) const;
+  void operator()(Strategy &) const;
+
+ protected:
+  template <typename Handler>
+  void replay(Handler &) const;
+
+ private:
+  std::span<std::byte const> data_;
+};
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,58 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#include "roq/api.hpp"
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// event log writer
+//
+// records market data so it can later be replayed (memory mapped) by the event log reader
+//
+// note! the source name is recorded the first time a source is seen
+
+struct ROQ_PUBLIC EventLogWriter final {
+  explicit EventLogWriter(std::string_view const &path);
+
+  EventLogWriter(EventLogWriter const &) = delete;
+
+  ~EventLogWriter();
+
+  void flush();
+
+  void operator()(Event<ReferenceData> const &);
+  void operator()(Event<MarketStatus> const &);
+  void operator()(Event<TopOfBook> const &);
+  void operator()(Event<MarketByPriceUpdate> const &);
+  void operator()(Event<MarketByOrderUpdate> const &);
+  void operator()(Event<TradeSummary> const &);
+
+ protected:
+  template <typename T>
+  void write(Event<T> const &);
+
+  void write_source(MessageInfo const &);
+
+  void write_buffer();
+
+ private:
+  std::FILE *file_ = nullptr;
+  // note! re-used
+  std::vector<std::byte> buffer_;
+  std::array<bool, 256> sources_ = {};
+};
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
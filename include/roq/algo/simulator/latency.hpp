@@ -0,0 +1,84 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// latency (distribution)
+//
+// base + uniform(0, jitter) + min(pareto(tail_scale, tail_shape), tail_max) with probability tail_probability
+//
+// note! a lower tail_shape means a fatter tail (MIN_TAIL_SHAPE => finite mean)
+// note! the pareto distribution is unbounded and the tail is therefore clamped to tail_max
+
+struct ROQ_PUBLIC Latency final {
+  static constexpr double const MIN_TAIL_SHAPE = 1.0;
+
+  std::chrono::nanoseconds base = {};
+  std::chrono::nanoseconds jitter = {};
+  double tail_probability = {};
+  std::chrono::nanoseconds tail_scale = {};
+  double tail_shape = 2.0;
+  std::chrono::nanoseconds tail_max = std::chrono::seconds{1};
+
+  bool is_fixed() const { return jitter.count() == 0 && (tail_probability <= 0.0 || tail_scale.count() == 0); }
+
+  template <typename Generator>
+  std::chrono::nanoseconds sample(Generator &generator) const {
+    if (is_fixed()) {
+      return base;
+    }
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+    auto result = static_cast<double>(base.count());
+    if (jitter.count() > 0) {
+      result += distribution(generator) * static_cast<double>(jitter.count());
+    }
+    if (tail_probability > 0.0 && distribution(generator) < tail_probability) {
+      // note! inverse transform, u in (0, 1]
+      auto u = 1.0 - distribution(generator);
+      auto tail = static_cast<double>(tail_scale.count()) * std::pow(u, -1.0 / tail_shape);
+      result += std::min(tail, static_cast<double>(tail_max.count()));
+    }
+    return std::chrono::nanoseconds{static_cast<int64_t>(std::llround(result))};
+  }
+};
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
+
+template <>
+struct fmt::formatter<roq::algo::simulator::Latency> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::algo::simulator::Latency const &value, format_context &context) const {
+    using namespace std::literals;
+    return fmt::format_to(
+        context.out(),
+        R"({{)"
+        R"(base={}, )"
+        R"(jitter={}, )"
+        R"(tail_probability={}, )"
+        R"(tail_scale={}, )"
+        R"(tail_shape={}, )"
+        R"(tail_max={})"
+        R"(}})"sv,
+        value.base,
+        value.jitter,
+        value.tail_probability,
+        value.tail_scale,
+        value.tail_shape,
+        value.tail_max);
+  }
+};
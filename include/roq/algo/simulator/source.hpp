@@ -16,6 +16,8 @@
 
 #include "roq/utils/container.hpp"
 
+#include "roq/algo/simulator/latency.hpp"
+
 namespace roq {
 namespace algo {
 namespace simulator {
@@ -37,9 +39,14 @@ struct ROQ_PUBLIC Account final {
   utils::unordered_map<std::string, Exchange> exchanges;
 };
 
+// note! the fixed latencies are kept for compatibility
+// - order_management_latency is the base of the distribution (truncated to milliseconds, a warning is logged)
+// - order_management_latency_distribution has nanosecond resolution (see Sweep::Config::order_management_latency)
+
 struct ROQ_PUBLIC Source final {
   std::chrono::milliseconds market_data_latency = {};
   std::chrono::milliseconds order_management_latency = {};
+  Latency order_management_latency_distribution;
   utils::unordered_map<std::string, Account> accounts;
 };
 
@@ -115,10 +122,12 @@ struct fmt::formatter<roq::algo::simulator::Source> {
         R"({{)"
         R"(market_data_latency={}, )"
         R"(order_management_latency={}, )"
+        R"(order_management_latency_distribution={}, )"
         R"(accounts={})"
         R"(}})"sv,
         value.market_data_latency,
         value.order_management_latency,
+        value.order_management_latency_distribution,
         fmt::join(value.accounts, ", "sv));
   }
 };
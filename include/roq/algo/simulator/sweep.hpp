@@ -0,0 +1,124 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/algo/market_data_source.hpp"
+#include "roq/algo/order_cache.hpp"
+#include "roq/algo/reporter.hpp"
+#include "roq/algo/strategy.hpp"
+
+#include "roq/algo/matcher/type.hpp"
+
+#include "roq/algo/simulator/latency.hpp"
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// sweep (parameter variants)
+//
+// the same (decoded) event stream is replayed through many independent pipelines
+// - each pipeline is a strategy, a matcher group and a reporter (plus an order cache)
+// - pipelines share nothing (except the read-only event stream) and are processed concurrently
+// - pipelines are partitioned into one batch per worker (no pipeline is ever split)
+// - the event stream is replayed (decoded) once per batch and each event is fanned out to all pipelines of the batch
+//
+// results are collected through the reporter (Reporter::dispatch) once run has returned
+//
+// note! the source must be safe to replay concurrently (e.g. memory mapped), events are only valid during the callback
+// note! factories are called from the worker threads and must therefore be thread-safe
+// note! requests are delayed by the order management latency of their source (sampled using a per-pipeline seed)
+// note! requests with a duplicate (create) or unknown (modify, cancel) order_id are rejected before reaching the matcher
+// note! zero latency for acks, order updates and market data (only requests are held in the timing wheel)
+// note! requests still in-flight at the end of the event stream are processed (a warning is logged if any are dropped)
+
+struct ROQ_PUBLIC Sweep final {
+  // note! receives the replayed event stream (one per pipeline)
+  struct ROQ_PUBLIC Handler {
+    // host
+    virtual void operator()(Event<Timer> const &) = 0;
+
+    // connection
+    virtual void operator()(Event<Connected> const &) = 0;
+    virtual void operator()(Event<Disconnected> const &) = 0;
+
+    // download
+    virtual void operator()(Event<DownloadBegin> const &) = 0;
+    virtual void operator()(Event<DownloadEnd> const &) = 0;
+    virtual void operator()(Event<Ready> const &) = 0;
+
+    // config
+    virtual void operator()(Event<GatewaySettings> const &) = 0;
+
+    // stream
+    virtual void operator()(Event<StreamStatus> const &) = 0;
+    virtual void operator()(Event<ExternalLatency> const &) = 0;
+    virtual void operator()(Event<RateLimitTrigger> const &) = 0;
+
+    // service
+    virtual void operator()(Event<GatewayStatus> const &) = 0;
+
+    // market data
+    virtual void operator()(Event<ReferenceData> const &) = 0;
+    virtual void operator()(Event<MarketStatus> const &) = 0;
+    virtual void operator()(Event<TopOfBook> const &) = 0;
+    virtual void operator()(Event<MarketByPriceUpdate> const &) = 0;
+    virtual void operator()(Event<MarketByOrderUpdate> const &) = 0;
+    virtual void operator()(Event<TradeSummary> const &) = 0;
+    virtual void operator()(Event<StatisticsUpdate> const &) = 0;
+
+    // account management
+    virtual void operator()(Event<PositionUpdate> const &) = 0;
+    virtual void operator()(Event<FundsUpdate> const &) = 0;
+  };
+
+  // note! must be safe to replay concurrently (const), replayed once per batch
+  struct ROQ_PUBLIC Source {
+    virtual ~Source() = default;
+
+    virtual void operator()(Handler &) const = 0;
+  };
+
+  struct Config final {
+    size_t size = {};     // number of pipelines (variants)
+    size_t threads = {};  // zero => hardware concurrency
+    matcher::Type matcher_type = {};
+    MarketDataSource market_data_source = {};
+    std::vector<Latency> order_management_latency;  // note! strategy => matcher, indexed by source (zero if missing)
+  };
+
+  using CreateStrategy = std::function<std::unique_ptr<Strategy>(size_t index, Strategy::Dispatcher &, OrderCache &)>;
+  using CreateReporter = std::function<std::unique_ptr<Reporter>(size_t index)>;
+
+  Sweep(Config const &, CreateStrategy const &, CreateReporter const &);
+
+  Sweep(Sweep const &) = delete;
+
+  ~Sweep();
+
+  size_t size() const { return config_.size; }
+
+  // note! blocks until all pipelines have completed, the first exception (if any) is re-thrown
+  void run(Source const &);
+
+  // note! only valid after run
+  Reporter const &get_reporter(size_t index) const;
+
+ private:
+  Config const config_;
+  CreateStrategy const create_strategy_;
+  CreateReporter const create_reporter_;
+  std::vector<std::unique_ptr<Reporter>> reporters_;
+};
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,206 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// timing wheel (hierarchical, nanosecond resolution)
+//
+// delayed events (e.g. in-flight requests and acks)
+// - insert is O(1): the level is the highest byte where the expiry differs from the current time
+// - expiry is O(1) amortized: an event cascades (at most) once per level before being dispatched
+// - empty slots are skipped using an occupancy bitmap per level (time can jump arbitrarily far)
+// - events with the same expiry are dispatched in insertion order
+//
+// note! events in the past are dispatched as soon as possible (the current time never moves backwards)
+// note! the callback may push new events (the value is moved out before the callback is invoked)
+
+template <typename T>
+struct TimingWheel final {
+  TimingWheel() = default;
+
+  TimingWheel(TimingWheel &&) = default;
+  TimingWheel(TimingWheel const &) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // note! time of the last dispatched event (or cascaded slot)
+  std::chrono::nanoseconds now() const { return std::chrono::nanoseconds{static_cast<int64_t>(current_)}; }
+
+  template <typename... Args>
+  void emplace(std::chrono::nanoseconds expiry, Args &&...args) {
+    auto index = allocate(std::max<uint64_t>(to_ticks(expiry), current_), std::forward<Args>(args)...);
+    insert(index);
+    ++size_;
+  }
+
+  void push(std::chrono::nanoseconds expiry, T &&value) { emplace(expiry, std::move(value)); }
+  void push(std::chrono::nanoseconds expiry, T const &value) { emplace(expiry, value); }
+
+  // note! dispatches all events with expiry <= now
+  template <typename Callback>
+  void advance(std::chrono::nanoseconds now, Callback callback) {
+    auto target = to_ticks(now);
+    while (size_ > 0) {
+      auto [level, slot] = find_next();
+      assert(level < LEVELS);
+      auto start = get_start(level, slot);
+      if (start > target) {
+        break;
+      }
+      current_ = start;
+      auto &[head, tail] = levels_[level].slots[slot];
+      auto index = std::exchange(head, NIL);
+      tail = NIL;
+      clear_occupied(level, slot);
+      if (level == 0) {
+        // note! all events have the same expiry
+        while (index != NIL) {
+          auto &node = nodes_[index];
+          auto next = node.next;
+          auto value = std::move(node.value);
+          release(index);
+          --size_;
+          callback(std::chrono::nanoseconds{static_cast<int64_t>(current_)}, value);
+          index = next;
+        }
+      } else {
+        // note! cascade (each event will be inserted at a lower level)
+        while (index != NIL) {
+          auto next = nodes_[index].next;
+          insert(index);
+          index = next;
+        }
+      }
+    }
+  }
+
+ protected:
+  static constexpr uint32_t const NIL = std::numeric_limits<uint32_t>::max();
+  static constexpr size_t const BITS = 8;
+  static constexpr size_t const SLOTS = size_t{1} << BITS;
+  static constexpr size_t const LEVELS = 64 / BITS;
+  static constexpr uint64_t const MASK = SLOTS - 1;
+  static constexpr size_t const WORDS = SLOTS / 64;
+
+  struct Node final {
+    uint64_t expiry = {};
+    uint32_t next = NIL;
+    T value;
+  };
+
+  struct Slot final {
+    uint32_t head = NIL;
+    uint32_t tail = NIL;
+  };
+
+  struct Level final {
+    std::array<Slot, SLOTS> slots;
+    std::array<uint64_t, WORDS> occupied = {};
+  };
+
+  static uint64_t to_ticks(std::chrono::nanoseconds value) { return static_cast<uint64_t>(std::max<int64_t>(value.count(), 0)); }
+
+  template <typename... Args>
+  uint32_t allocate(uint64_t expiry, Args &&...args) {
+    uint32_t index;
+    if (free_ != NIL) {
+      index = free_;
+      auto &node = nodes_[index];
+      free_ = node.next;
+      node.expiry = expiry;
+      node.next = NIL;
+      node.value = T{std::forward<Args>(args)...};
+    } else {
+      index = static_cast<uint32_t>(std::size(nodes_));
+      nodes_.push_back({.expiry = expiry, .next = NIL, .value = T{std::forward<Args>(args)...}});
+    }
+    return index;
+  }
+
+  void release(uint32_t index) {
+    auto &node = nodes_[index];
+    node.value = {};
+    node.next = free_;
+    free_ = index;
+  }
+
+  void insert(uint32_t index) {
+    auto &node = nodes_[index];
+    node.next = NIL;
+    auto diff = node.expiry ^ current_;
+    auto level = diff == 0 ? size_t{0} : static_cast<size_t>((63 - std::countl_zero(diff)) / BITS);
+    auto slot = (node.expiry >> (level * BITS)) & MASK;
+    auto &[head, tail] = levels_[level].slots[slot];
+    if (tail == NIL) {
+      head = index;
+      set_occupied(level, slot);
+    } else {
+      nodes_[tail].next = index;
+    }
+    tail = index;
+  }
+
+  // note! same upper bits as the current time
+  uint64_t get_start(size_t level, uint64_t slot) const {
+    auto shift = (level + 1) * BITS;
+    auto upper = shift < 64 ? ((current_ >> shift) << shift) : uint64_t{0};
+    return upper | (slot << (level * BITS));
+  }
+
+  // note! level 0 includes the current slot, higher levels only include later slots
+  std::pair<size_t, uint64_t> find_next() const {
+    for (size_t level = 0; level < LEVELS; ++level) {
+      auto current = (current_ >> (level * BITS)) & MASK;
+      auto first = level == 0 ? current : current + 1;
+      auto slot = find_occupied(level, first);
+      if (slot < SLOTS) {
+        return {level, slot};
+      }
+    }
+    return {LEVELS, SLOTS};
+  }
+
+  uint64_t find_occupied(size_t level, uint64_t first) const {
+    auto &occupied = levels_[level].occupied;
+    for (auto word = first / 64; word < WORDS; ++word) {
+      auto bits = occupied[word];
+      if (word == first / 64) {
+        bits &= ~uint64_t{0} << (first % 64);
+      }
+      if (bits != 0) {
+        return word * 64 + static_cast<uint64_t>(std::countr_zero(bits));
+      }
+    }
+    return SLOTS;
+  }
+
+  void set_occupied(size_t level, uint64_t slot) { levels_[level].occupied[slot / 64] |= uint64_t{1} << (slot % 64); }
+  void clear_occupied(size_t level, uint64_t slot) { levels_[level].occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64)); }
+
+ private:
+  uint64_t current_ = {};
+  size_t size_ = {};
+  std::array<Level, LEVELS> levels_;
+  // note! node pool (indices are stable, memory is re-used)
+  std::vector<Node> nodes_;
+  uint32_t free_ = NIL;
+};
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,138 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <magic_enum/magic_enum_format.hpp>
+
+#include <chrono>
+#include <string_view>
+#include <utility>
+
+#include "roq/logging.hpp"
+
+#include "roq/algo/leg.hpp"
+#include "roq/algo/market_data_source.hpp"
+
+#include "roq/algo/tools/market_data_book.hpp"
+#include "roq/algo/tools/market_data_state.hpp"
+
+namespace roq {
+namespace algo {
+namespace tools {
+
+// market data (compile-time market data source)
+//
+// note! only the book required by the market data source is maintained (no runtime dispatch)
+// note! the book is created lazily on the first event it must observe
+
+template <MarketDataSource market_data_source>
+struct BasicMarketData final {
+  BasicMarketData(std::string_view const &exchange, std::string_view const &symbol) : state_{market_data_source}, book_{exchange, symbol} {}
+  explicit BasicMarketData(Leg const &leg) : state_{leg, market_data_source}, book_{leg.exchange, leg.symbol} {}
+
+  // note! same signature as MarketData (the market data source must match)
+  BasicMarketData(std::string_view const &exchange, std::string_view const &symbol, MarketDataSource market_data_source_2)
+      : BasicMarketData{exchange, symbol} {
+    check(market_data_source_2);
+  }
+  BasicMarketData(Leg const &leg, MarketDataSource market_data_source_2) : BasicMarketData{leg} { check(market_data_source_2); }
+
+  BasicMarketData(BasicMarketData &&) = default;
+  BasicMarketData(BasicMarketData const &) = delete;
+
+  static constexpr MarketDataSource get_market_data_source() { return market_data_source; }
+
+  bool has_tick_size() const { return state_.has_tick_size(); }
+
+  bool is_market_active(MessageInfo const &message_info, std::chrono::nanoseconds max_age = {}) const {
+    return state_.is_market_active(message_info, max_age);
+  }
+
+  std::pair<int64_t, bool> price_to_ticks(double price) const { return state_.price_to_ticks(price); }
+
+  // note! internal prices (ticks) must be multiplied by this factor following a change of tick size (1 => no change)
+  // - zero => the new tick size does not divide the old tick size and internal prices must be re-derived from external prices
+  // - only valid immediately after ReferenceData (reset for each update)
+  int64_t get_rescale_factor() const { return state_.get_rescale_factor(); }
+
+  // note! depends on MarketDataSource
+  Layer const &top_of_book() const { return state_.top_of_book(); }
+
+  // note! only possible with MbP or MbO (returns zero before the book has been created)
+  double total_quantity(Side side, double price) const { return book_.total_quantity(side, price); }
+
+  // note! depends on MarketDataSource (see MarketDataBook)
+  template <typename Callback>
+  void for_each_level(Side side, Callback callback) const {
+    book_.for_each_level(side, state_.top_of_book(), callback);
+  }
+
+  double get_tick_size() const { return state_.get_tick_size(); }
+  double get_multiplier() const { return state_.get_multiplier(); }
+  double get_min_trade_vol() const { return state_.get_min_trade_vol(); }
+
+  TradingStatus get_trading_status() const { return state_.get_trading_status(); }
+
+  std::chrono::nanoseconds exchange_time_utc() const { return state_.exchange_time_utc(); }
+
+  bool operator()(Event<ReferenceData> const &event) {
+    book_(event);
+    return state_(event);
+  }
+
+  bool operator()(Event<MarketStatus> const &event) { return state_(event); }
+
+  // note! depends on MarketDataSource
+  bool operator()(Event<TopOfBook> const &event) { return state_(event); }
+  bool operator()(Event<MarketByPriceUpdate> const &event) { return update_best(event); }
+  bool operator()(Event<MarketByOrderUpdate> const &event) { return update_best(event); }
+
+  bool operator()(Event<TradeSummary> const &event) {
+    state_(event);
+    return true;  // note! only incremental
+  }
+
+  void operator()(Event<StatisticsUpdate> const &event) { state_(event); }
+
+  template <typename OutputIt>
+  auto constexpr format_helper(OutputIt out) const {
+    return state_.format_helper(out);
+  }
+
+ protected:
+  static void check(MarketDataSource market_data_source_2) {
+    using namespace std::literals;
+    if (market_data_source_2 != market_data_source) [[unlikely]] {
+      throw RuntimeError{"Unexpected: market_data_source={} (expected {})"sv, market_data_source_2, market_data_source};
+    }
+  }
+
+  template <typename T>
+  bool update_best(Event<T> const &event) {
+    state_(event);
+    auto best = state_.top_of_book();  // note! copy (the book could leave some fields unchanged)
+    if (!book_(event, best)) {
+      return false;
+    }
+    state_.set_best(best);
+    return true;
+  }
+
+ private:
+  MarketDataState state_;
+  MarketDataBook<market_data_source> book_;
+};
+
+}  // namespace tools
+}  // namespace algo
+}  // namespace roq
+
+template <roq::algo::MarketDataSource market_data_source>
+struct fmt::formatter<roq::algo::tools::BasicMarketData<market_data_source>> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::algo::tools::BasicMarketData<market_data_source> const &value, format_context &context) const {
+    return value.format_helper(context.out());
+  }
+};
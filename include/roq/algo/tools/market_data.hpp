@@ -7,27 +7,24 @@
 #include <fmt/format.h>
 
 #include <chrono>
-#include <limits>
-#include <memory>
 #include <string_view>
-
-#include "roq/reference_data.hpp"
-#include "roq/statistics_update.hpp"
-#include "roq/top_of_book.hpp"
-#include "roq/trade_summary.hpp"
-
-#include "roq/cache/market_by_order.hpp"
-#include "roq/cache/market_by_price.hpp"
-#include "roq/cache/market_status.hpp"
-#include "roq/cache/top_of_book.hpp"
+#include <variant>
 
 #include "roq/algo/leg.hpp"
 #include "roq/algo/market_data_source.hpp"
 
+#include "roq/algo/tools/market_data_book.hpp"
+#include "roq/algo/tools/market_data_state.hpp"
+
 namespace roq {
 namespace algo {
 namespace tools {
 
+// market data (runtime market data source)
+//
+// note! facade dispatching to the compile-time specialization of the book (MarketDataBook)
+// - state shared by all market data sources is kept outside the variant (no runtime dispatch for scalar accessors)
+
 struct ROQ_PUBLIC MarketData final {
   MarketData(std::string_view const &exchange, std::string_view const &symbol, MarketDataSource);
   MarketData(Leg const &, MarketDataSource);
@@ -35,71 +32,69 @@ struct ROQ_PUBLIC MarketData final {
   MarketData(MarketData &&) = default;
   MarketData(MarketData const &) = delete;
 
-  bool has_tick_size() const { return !std::isnan(tick_size_) && precision_ != Precision{}; }
+  MarketDataSource get_market_data_source() const { return state_.get_market_data_source(); }
+
+  bool has_tick_size() const { return state_.has_tick_size(); }
+
+  bool is_market_active(MessageInfo const &message_info, std::chrono::nanoseconds max_age = {}) const {
+    return state_.is_market_active(message_info, max_age);
+  }
 
-  bool is_market_active(MessageInfo const &, std::chrono::nanoseconds max_age = {}) const;
+  std::pair<int64_t, bool> price_to_ticks(double price) const { return state_.price_to_ticks(price); }
 
-  std::pair<int64_t, bool> price_to_ticks(double price) const;
+  // note! only valid immediately after ReferenceData (zero => internal prices must be re-derived from external prices)
+  int64_t get_rescale_factor() const { return state_.get_rescale_factor(); }
 
   // note! depends on MarketDataSource
-  Layer const &top_of_book() const { return best_; }
+  Layer const &top_of_book() const { return state_.top_of_book(); }
 
   // note! only possible with MbP or MbO
   double total_quantity(Side, double price) const;
 
-  double get_tick_size() const { return tick_size_; }
-  double get_multiplier() const { return multiplier_; }
-  double get_min_trade_vol() const { return min_trade_vol_; }
+  // note! depends on MarketDataSource
+  template <typename Callback>
+  void for_each_level(Side side, Callback callback) const {
+    std::visit([&](auto &value) { value.for_each_level(side, state_.top_of_book(), callback); }, book_);
+  }
+
+  double get_tick_size() const { return state_.get_tick_size(); }
+  double get_multiplier() const { return state_.get_multiplier(); }
+  double get_min_trade_vol() const { return state_.get_min_trade_vol(); }
 
-  std::chrono::nanoseconds exchange_time_utc() const { return exchange_time_utc_; }
+  TradingStatus get_trading_status() const { return state_.get_trading_status(); }
+
+  std::chrono::nanoseconds exchange_time_utc() const { return state_.exchange_time_utc(); }
 
   bool operator()(Event<ReferenceData> const &);
-  bool operator()(Event<MarketStatus> const &);
+  bool operator()(Event<MarketStatus> const &event) { return state_(event); }
 
   // note! depends on MarketDataSource
-  bool operator()(Event<TopOfBook> const &);
+  bool operator()(Event<TopOfBook> const &event) { return state_(event); }
   bool operator()(Event<MarketByPriceUpdate> const &);
   bool operator()(Event<MarketByOrderUpdate> const &);
 
-  bool operator()(Event<TradeSummary> const &);
-  void operator()(Event<StatisticsUpdate> const &);
+  bool operator()(Event<TradeSummary> const &event) {
+    state_(event);
+    return true;  // note! only incremental
+  }
+  void operator()(Event<StatisticsUpdate> const &event) { state_(event); }
 
   template <typename OutputIt>
   auto constexpr format_helper(OutputIt out) const {
-    using namespace std::literals;
-    return fmt::format_to(
-        out,
-        R"({{)"
-        R"(tick_size={}, )"
-        R"(multiplier={}, )"
-        R"(min_trade_vol={}, )"
-        R"(trading_status={}, )"
-        R"(best={}, )"
-        R"(exchange_time_utc={}, )"
-        R"(latency={})"
-        R"(}})"sv,
-        tick_size_,
-        multiplier_,
-        min_trade_vol_,
-        market_status_.trading_status,
-        best_,
-        exchange_time_utc_,
-        latency_);
+    return state_.format_helper(out);
   }
 
+ protected:
+  template <typename T>
+  bool update_best(Event<T> const &);
+
  private:
-  MarketDataSource const market_data_source_;
-  double tick_size_ = NaN;
-  Precision precision_ = {};
-  double multiplier_ = NaN;
-  double min_trade_vol_ = NaN;
-  cache::MarketStatus market_status_;
-  cache::TopOfBook top_of_book_;
-  std::unique_ptr<cache::MarketByPrice> market_by_price_;
-  std::unique_ptr<cache::MarketByOrder> market_by_order_;
-  Layer best_ = {};
-  std::chrono::nanoseconds exchange_time_utc_ = {};
-  std::chrono::nanoseconds latency_ = {};
+  MarketDataState state_;
+  std::variant<
+      MarketDataBook<MarketDataSource::TOP_OF_BOOK>,
+      MarketDataBook<MarketDataSource::MARKET_BY_PRICE>,
+      MarketDataBook<MarketDataSource::MARKET_BY_ORDER>>
+      book_;
 };
 
 }  // namespace tools
@@ -0,0 +1,112 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <cmath>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "roq/reference_data.hpp"
+#include "roq/string_types.hpp"
+
+#include "roq/cache/market_by_order.hpp"
+#include "roq/cache/market_by_price.hpp"
+
+#include "roq/algo/market_data_source.hpp"
+
+namespace roq {
+namespace algo {
+namespace tools {
+
+// market data book (compile-time market data source)
+//
+// note! only the book required by the market data source is maintained (TopOfBook => no book)
+// note! the book is created lazily on the first event it must observe
+
+template <MarketDataSource market_data_source>
+struct ROQ_PUBLIC MarketDataBook final {
+  MarketDataBook(std::string_view const &exchange, std::string_view const &symbol);
+
+  MarketDataBook(MarketDataBook &&) = default;
+  MarketDataBook(MarketDataBook const &) = delete;
+
+  // note! only possible with MbP or MbO (returns zero before the book has been created)
+  double total_quantity(Side, double price) const;
+
+  // note! depends on MarketDataSource
+  // - callback(price, quantity) is invoked for each price level (best first) until it returns false
+  // - TopOfBook => only the best price level
+  // - MbP => cached price levels are visited in place (no copy)
+  // - MbO => orders must first be aggregated into price levels (re-used buffer)
+  template <typename Callback>
+  void for_each_level(Side, Layer const &best, Callback) const;
+
+  void operator()(Event<ReferenceData> const &);
+
+  // note! depends on MarketDataSource (best price level is only extracted if the book is maintained)
+  bool operator()(Event<MarketByPriceUpdate> const &, Layer &best);
+  bool operator()(Event<MarketByOrderUpdate> const &, Layer &best);
+
+ private:
+  using Book = std::conditional_t<
+      market_data_source == MarketDataSource::MARKET_BY_PRICE,
+      std::unique_ptr<cache::MarketByPrice>,
+      std::conditional_t<market_data_source == MarketDataSource::MARKET_BY_ORDER, std::unique_ptr<cache::MarketByOrder>, std::monostate>>;
+
+  auto &get_book()
+    requires(market_data_source != MarketDataSource::TOP_OF_BOOK);
+
+  Exchange exchange_;
+  Symbol symbol_;
+  [[no_unique_address]] Book book_;
+  using Levels = std::conditional_t<market_data_source == MarketDataSource::MARKET_BY_ORDER, std::vector<MBPUpdate>, std::monostate>;
+  [[no_unique_address]] mutable Levels levels_;
+};
+
+// === IMPLEMENTATION ===
+
+template <MarketDataSource market_data_source>
+template <typename Callback>
+void MarketDataBook<market_data_source>::for_each_level(Side side, Layer const &best, Callback callback) const {
+  auto helper = [&](auto price, auto quantity) {
+    if (std::isnan(price) || std::isnan(quantity)) {
+      return;
+    }
+    callback(price, quantity);
+  };
+  if constexpr (market_data_source == MarketDataSource::TOP_OF_BOOK) {
+    if (side == Side::BUY) {
+      helper(best.bid_price, best.bid_quantity);
+    } else {
+      helper(best.ask_price, best.ask_quantity);
+    }
+  } else {
+    if (!book_) {
+      return;
+    }
+    auto levels = [&]() -> std::span<MBPUpdate const> {
+      if constexpr (market_data_source == MarketDataSource::MARKET_BY_PRICE) {
+        return side == Side::BUY ? (*book_).bids() : (*book_).asks();
+      } else {
+        auto [bids, asks] = (*book_).size();
+        levels_.resize(side == Side::BUY ? bids : asks);
+        return (*book_).extract(levels_, side);
+      }
+    }();
+    for (auto &item : levels) {
+      if (!callback(item.price, item.quantity)) {
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace tools
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,124 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "roq/reference_data.hpp"
+#include "roq/statistics_update.hpp"
+#include "roq/top_of_book.hpp"
+#include "roq/trade_summary.hpp"
+
+#include "roq/cache/market_status.hpp"
+#include "roq/cache/top_of_book.hpp"
+
+#include "roq/algo/leg.hpp"
+#include "roq/algo/market_data_source.hpp"
+
+namespace roq {
+namespace algo {
+namespace tools {
+
+// market data state (independent of the market data source)
+//
+// note! reference data, market status and the best price level (no book, no runtime dispatch)
+// note! the best price level is maintained here for TopOfBook and extracted from the book (MarketDataBook) for MbP or MbO
+
+struct ROQ_PUBLIC MarketDataState final {
+  explicit MarketDataState(MarketDataSource);
+  MarketDataState(Leg const &, MarketDataSource);
+
+  MarketDataState(MarketDataState &&) = default;
+  MarketDataState(MarketDataState const &) = delete;
+
+  MarketDataSource get_market_data_source() const { return market_data_source_; }
+
+  bool has_tick_size() const { return !std::isnan(tick_size_) && precision_ != Precision{}; }
+
+  bool is_market_active(MessageInfo const &, std::chrono::nanoseconds max_age = {}) const;
+
+  std::pair<int64_t, bool> price_to_ticks(double price) const;
+
+  // note! internal prices (ticks) must be multiplied by this factor following a change of tick size (1 => no change)
+  // - zero => the new tick size does not divide the old tick size and internal prices must be re-derived from external prices
+  // - only valid immediately after ReferenceData (reset for each update)
+  int64_t get_rescale_factor() const { return rescale_factor_; }
+
+  Layer const &top_of_book() const { return best_; }
+
+  double get_tick_size() const { return tick_size_; }
+  double get_multiplier() const { return multiplier_; }
+  double get_min_trade_vol() const { return min_trade_vol_; }
+
+  TradingStatus get_trading_status() const { return market_status_.trading_status; }
+
+  std::chrono::nanoseconds exchange_time_utc() const { return exchange_time_utc_; }
+
+  bool operator()(Event<ReferenceData> const &);
+  bool operator()(Event<MarketStatus> const &);
+
+  // note! depends on MarketDataSource
+  bool operator()(Event<TopOfBook> const &);
+
+  // note! only the exchange time is updated (the book is not maintained here)
+  void operator()(Event<MarketByPriceUpdate> const &);
+  void operator()(Event<MarketByOrderUpdate> const &);
+
+  void operator()(Event<TradeSummary> const &);
+  void operator()(Event<StatisticsUpdate> const &);
+
+  // note! MbP or MbO => best price level extracted from the book
+  void set_best(Layer const &best) { best_ = best; }
+
+  template <typename OutputIt>
+  auto constexpr format_helper(OutputIt out) const {
+    using namespace std::literals;
+    return fmt::format_to(
+        out,
+        R"({{)"
+        R"(tick_size={}, )"
+        R"(multiplier={}, )"
+        R"(min_trade_vol={}, )"
+        R"(trading_status={}, )"
+        R"(best={}, )"
+        R"(exchange_time_utc={}, )"
+        R"(latency={})"
+        R"(}})"sv,
+        tick_size_,
+        multiplier_,
+        min_trade_vol_,
+        market_status_.trading_status,
+        best_,
+        exchange_time_utc_,
+        latency_);
+  }
+
+ private:
+  MarketDataSource const market_data_source_;
+  double tick_size_ = NaN;
+  Precision precision_ = {};
+  int64_t rescale_factor_ = 1;
+  double multiplier_ = NaN;
+  double min_trade_vol_ = NaN;
+  cache::MarketStatus market_status_;
+  cache::TopOfBook top_of_book_;
+  Layer best_ = {};
+  std::chrono::nanoseconds exchange_time_utc_ = {};
+  std::chrono::nanoseconds latency_ = {};
+};
+
+}  // namespace tools
+}  // namespace algo
+}  // namespace roq
+
+template <>
+struct fmt::formatter<roq::algo::tools::MarketDataState> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::algo::tools::MarketDataState const &value, format_context &context) const { return value.format_helper(context.out()); }
+};
@@ -25,7 +25,7 @@ namespace arbitrage {
 // === CONSTANTS ===
 
 namespace {
-std::array<strategy::Meta, 7> const META{{
+std::array<strategy::Meta, 8> const META{{
     {
         .name = "market_data_source"sv,
         .type = VariantType::ENUM,
@@ -68,6 +68,12 @@ std::array<strategy::Meta, 7> const META{{
         .required = false,
         .description = "Source (index) used for publishing custom metrics"sv,
     },
+    {
+        .name = "publish_interval_ms"sv,
+        .type = VariantType::UINT32,
+        .required = false,
+        .description = "Minimum interval between publishing custom metrics (milliseconds, changes are conflated)"sv,
+    },
 }};
 
 auto const DEFAULT_MAX_AGE = 10s;
@@ -90,6 +96,7 @@ auto parameters_from_string(auto &parameters) {
       MIN_POSITION_0,
       MAX_POSITION_0,
       PUBLISH_SOURCE,
+      PUBLISH_INTERVAL_MS,
     };
     auto key_2 = utils::parse_enum<Key>(key);
     log::debug(R"(key={}, value="{}")"sv, key_2, value);
@@ -115,6 +122,12 @@ auto parameters_from_string(auto &parameters) {
       case Key::PUBLISH_SOURCE:
         utils::variant::parse(result.publish_source, value);
         break;
+      case Key::PUBLISH_INTERVAL_MS: {
+        uint32_t publish_interval_ms = {};
+        utils::variant::parse(publish_interval_ms, value);
+        result.publish_interval = std::chrono::milliseconds{publish_interval_ms};
+        break;
+      }
     }
   };
   utils::key_value::Parser::dispatch(parameters, callback);
@@ -7,7 +7,6 @@
 #include <magic_enum/magic_enum_format.hpp>
 
 #include <string>
-#include <utility>
 
 #include "roq/api.hpp"
 
@@ -35,12 +34,9 @@ struct Instrument final {
 
   Layer const &top_of_book() const { return market_data_.top_of_book(); }
 
-  std::pair<double, double> get_best() const {
-    auto &top_of_book = market_data_.top_of_book();
-    return {top_of_book.bid_price, top_of_book.ask_price};
-  }
+  TradingStatus get_trading_status() const { return market_data_.get_trading_status(); }
 
-  bool is_ready(MessageInfo const &, std::chrono::nanoseconds max_age) const;
+  std::chrono::nanoseconds exchange_time_utc() const { return market_data_.exchange_time_utc(); }
 
   // order management
 
@@ -73,7 +69,6 @@ struct Instrument final {
         R"(account="{}", )"
         R"(market_data={}, )"
         R"(position_tracker={}, )"
-        R"(order_state={}, )"
         R"(order_id={})"
         R"(}})"sv,
         source,
@@ -82,15 +77,9 @@ struct Instrument final {
         account,
         market_data_,
         position_tracker_,
-        order_state,
         order_id);
   }
 
- protected:
-  bool is_market_active(MessageInfo const &message_info, std::chrono::nanoseconds max_age) const {
-    return market_data_.is_market_active(message_info, max_age);
-  }
-
  public:
   uint8_t const source = {};
   std::string const exchange;
@@ -105,8 +94,7 @@ struct Instrument final {
   tools::PositionTracker position_tracker_;
 
  public:
-  OrderState order_state = {};
-  uint64_t order_id = {};
+  uint64_t order_id = {};  // note! order state is hot (see InstrumentState)
 };
 
 }  // namespace arbitrage
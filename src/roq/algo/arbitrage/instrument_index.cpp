@@ -0,0 +1,86 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/arbitrage/instrument_index.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include "roq/logging.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// === HELPERS ===
+
+namespace {
+auto create_key(auto &value) {
+  return std::tie(value.source, value.symbol, value.exchange);
+}
+
+template <typename R>
+auto create_entries(auto &instruments) {
+  using result_type = std::remove_cvref_t<R>;
+  result_type result;
+  result.reserve(std::size(instruments));
+  for (size_t i = 0; i < std::size(instruments); ++i) {
+    auto &item = instruments[i];
+    result.push_back({
+        .source = item.source,
+        .symbol = item.symbol,
+        .exchange = item.exchange,
+        .index = i,
+    });
+  }
+  auto compare = [](auto &lhs, auto &rhs) { return create_key(lhs) < create_key(rhs); };
+  std::sort(std::begin(result), std::end(result), compare);
+  auto equal = [](auto &lhs, auto &rhs) { return create_key(lhs) == create_key(rhs); };
+  auto iter = std::adjacent_find(std::begin(result), std::end(result), equal);
+  if (iter != std::end(result)) [[unlikely]] {
+    log::fatal(R"(Unexpected: duplicate leg (source={}, exchange="{}", symbol="{}"))"sv, (*iter).source, (*iter).exchange, (*iter).symbol);
+  }
+  return result;
+}
+
+template <typename R>
+auto create_offsets(auto &entries) {
+  using result_type = std::remove_cvref_t<R>;
+  size_t size = std::empty(entries) ? 0 : (entries.back().source + 1);
+  result_type result(size + 1);
+  for (size_t i = 0; i <= size; ++i) {
+    auto iter = std::lower_bound(std::begin(entries), std::end(entries), i, [](auto &lhs, auto rhs) { return lhs.source < rhs; });
+    result[i] = static_cast<size_t>(iter - std::begin(entries));
+  }
+  return result;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+InstrumentIndex::InstrumentIndex(std::span<Instrument const> const &instruments)
+    : entries_{create_entries<decltype(entries_)>(instruments)}, offsets_{create_offsets<decltype(offsets_)>(entries_)} {
+}
+
+size_t InstrumentIndex::find(uint8_t source, std::string_view const &exchange, std::string_view const &symbol) const {
+  auto range = get_range(source);
+  auto key = std::tie(symbol, exchange);
+  auto iter = std::lower_bound(std::begin(range), std::end(range), key, [](auto &lhs, auto &rhs) { return std::tie(lhs.symbol, lhs.exchange) < rhs; });
+  if (iter == std::end(range) || std::tie((*iter).symbol, (*iter).exchange) != key) {
+    return NOT_FOUND;
+  }
+  return (*iter).index;
+}
+
+std::span<InstrumentIndex::Entry const> InstrumentIndex::get_range(uint8_t source) const {
+  if ((size_t{source} + 1) >= std::size(offsets_)) {
+    return {};
+  }
+  auto begin = std::data(entries_);
+  return {begin + offsets_[source], begin + offsets_[source + 1]};
+}
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
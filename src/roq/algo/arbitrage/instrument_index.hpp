@@ -0,0 +1,62 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "roq/algo/arbitrage/instrument.hpp"
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// instrument index
+//
+// flat (immutable) lookup table built from the legs
+// - entries are sorted by (source, symbol, exchange), each source is a contiguous range
+// - lookup is a direct offset (source) followed by a binary search (no hashing)
+//
+// note! keys are views into the instruments (must outlive the index)
+
+struct InstrumentIndex final {
+  static constexpr size_t const NOT_FOUND = std::numeric_limits<size_t>::max();
+
+  explicit InstrumentIndex(std::span<Instrument const> const &instruments);
+
+  InstrumentIndex(InstrumentIndex &&) = default;
+  InstrumentIndex(InstrumentIndex const &) = delete;
+
+  size_t size() const { return std::size(entries_); }
+
+  // note! returns NOT_FOUND if the instrument is not a leg
+  size_t find(uint8_t source, std::string_view const &exchange, std::string_view const &symbol) const;
+
+  template <typename Callback>
+  void get_by_source(uint8_t source, Callback callback) const {
+    for (auto &item : get_range(source)) {
+      callback(item.index);
+    }
+  }
+
+ protected:
+  struct Entry final {
+    uint8_t source = {};
+    std::string_view symbol;
+    std::string_view exchange;
+    size_t index = {};
+  };
+
+  std::span<Entry const> get_range(uint8_t source) const;
+
+ private:
+  std::vector<Entry> entries_;
+  // note! entries for source are [offsets_[source], offsets_[source + 1])
+  std::vector<size_t> offsets_;
+};
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,62 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/arbitrage/instrument_state.hpp"
+
+#include <cmath>
+
+#include "roq/limits.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// === HELPERS ===
+
+namespace {
+bool has_liquidity(double price, double quantity) {
+  return !std::isnan(price) && !std::isnan(quantity) && quantity > 0.0;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+InstrumentState::InstrumentState(size_t size)
+    : bid_prices(size, NaN), bid_quantities(size, NaN), ask_prices(size, NaN), ask_quantities(size, NaN), trading_statuses(size),
+      exchange_times_utc(size), positions(size), order_states(size) {
+}
+
+// note! same logic as tools::MarketData
+bool InstrumentState::is_market_active(size_t index, MessageInfo const &message_info, std::chrono::nanoseconds max_age) const {
+  auto trading_status = trading_statuses[index];
+  if (trading_status != TradingStatus{}) {
+    return trading_status == TradingStatus::OPEN;
+  }
+  // use age of market data update as fallback if exchange doesn't support trading status
+  return (message_info.receive_time_utc - exchange_times_utc[index]) < max_age;
+}
+
+bool InstrumentState::is_ready(size_t index, MessageInfo const &message_info, std::chrono::nanoseconds max_age) const {
+  if (order_states[index] != OrderState::IDLE) {
+    return false;
+  }
+  // XXX FIXME TODO check rate-limit throttling
+  return is_market_active(index, message_info, max_age) && has_liquidity(bid_prices[index], bid_quantities[index]) &&
+         has_liquidity(ask_prices[index], ask_quantities[index]);
+}
+
+void InstrumentState::update(size_t index, Instrument const &instrument) {
+  auto &top_of_book = instrument.top_of_book();
+  bid_prices[index] = top_of_book.bid_price;
+  bid_quantities[index] = top_of_book.bid_quantity;
+  ask_prices[index] = top_of_book.ask_price;
+  ask_quantities[index] = top_of_book.ask_quantity;
+  trading_statuses[index] = instrument.get_trading_status();
+  exchange_times_utc[index] = instrument.exchange_time_utc();
+  positions[index] = instrument.current_position();
+}
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
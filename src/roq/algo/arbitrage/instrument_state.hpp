@@ -0,0 +1,59 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/algo/arbitrage/instrument.hpp"
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// instrument state (hot)
+//
+// structure-of-arrays, indexed like the instruments
+// - only what the spread scan needs (top of book, position, market status and order state)
+// - updated in place from the instrument (cold) following each event
+//
+// note! the order state is owned here (the instrument only keeps the order id)
+
+struct InstrumentState final {
+  explicit InstrumentState(size_t size);
+
+  InstrumentState(InstrumentState &&) = default;
+  InstrumentState(InstrumentState const &) = delete;
+
+  size_t size() const { return std::size(order_states); }
+
+  std::pair<double, double> get_best(size_t index) const { return {bid_prices[index], ask_prices[index]}; }
+
+  bool is_market_active(size_t index, MessageInfo const &, std::chrono::nanoseconds max_age) const;
+
+  bool is_ready(size_t index, MessageInfo const &, std::chrono::nanoseconds max_age) const;
+
+  // note! market data and position
+  void update(size_t index, Instrument const &);
+
+  void reset(size_t index) { order_states[index] = {}; }
+
+  // market data
+  std::vector<double> bid_prices;
+  std::vector<double> bid_quantities;
+  std::vector<double> ask_prices;
+  std::vector<double> ask_quantities;
+  std::vector<TradingStatus> trading_statuses;
+  std::vector<std::chrono::nanoseconds> exchange_times_utc;
+  // position
+  std::vector<double> positions;
+  // order management
+  std::vector<OrderState> order_states;
+};
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
@@ -67,21 +67,37 @@ auto create_sources(auto &instruments) {
     auto &item = instruments[i];
     tmp_1[item.source].try_emplace(item.account);
   }
-  // instruments
-  using instruments_type = std::remove_cvref_t<decltype(result_type::value_type::instruments)>;
-  std::vector<instruments_type> tmp_2(size);
-  for (size_t i = 0; i < std::size(instruments); ++i) {
-    auto &item = instruments[i];
-    tmp_2[item.source][item.exchange][item.symbol] = i;
-  }
   // source
-  for (size_t i = 0; i < size; ++i) {
-    auto &accounts = tmp_1[i];
-    auto &instruments = tmp_2[i];
-    result.emplace_back(std::move(accounts), std::move(instruments));
+  for (auto &accounts : tmp_1) {
+    result.emplace_back(std::move(accounts));
   }
   return result;
 }
+
+// NOLINTBEGIN(readability-magic-numbers)
+template <typename R>
+auto create_measurements() {
+  using result_type = std::remove_cvref_t<R>;
+  return result_type{{
+      {
+          .name = "bp"sv,
+          .value = NaN,
+      },
+      {
+          .name = "bq"sv,
+          .value = NaN,
+      },
+      {
+          .name = "ap"sv,
+          .value = NaN,
+      },
+      {
+          .name = "aq"sv,
+          .value = NaN,
+      },
+  }};
+}
+// NOLINTEND(readability-magic-numbers)
 }  // namespace
 
 // === IMPLEMENTATION ===
@@ -89,10 +105,14 @@ auto create_sources(auto &instruments) {
 Simple::Simple(Dispatcher &dispatcher, OrderCache &order_cache, strategy::Config const &config, Parameters const &parameters)
     : dispatcher_{dispatcher}, strategy_id_{config.strategy_id}, max_age_{parameters.max_age}, threshold_{parameters.threshold},
       quantity_0_{parameters.quantity_0}, min_position_0_{parameters.min_position_0}, max_position_0_{parameters.max_position_0},
-      publish_source_{parameters.publish_source}, market_data_type_{create_market_data_type(parameters)}, order_cache_{order_cache},
-      instruments_{create_instruments<decltype(instruments_)>(config, parameters)}, sources_{create_sources<decltype(sources_)>(instruments_)} {
+      publish_source_{parameters.publish_source}, publish_interval_{parameters.publish_interval},
+      market_data_type_{create_market_data_type(parameters)}, order_cache_{order_cache},
+      instruments_{create_instruments<decltype(instruments_)>(config, parameters)}, instrument_index_{instruments_},
+      instrument_state_{std::size(instruments_)}, spread_engine_{std::size(instruments_)}, sources_{create_sources<decltype(sources_)>(instruments_)},
+      is_dirty_(std::size(instruments_)), measurements_{create_measurements<decltype(measurements_)>()}, spread_matrix_{instruments_} {
   assert(!std::empty(instruments_));
   assert(!std::empty(sources_));
+  dirty_.reserve(std::size(instruments_));
 }
 
 void Simple::operator()(Event<Timer> const &event) {
@@ -100,6 +120,7 @@ void Simple::operator()(Event<Timer> const &event) {
   [[maybe_unused]] auto &[message_info, timer] = event;
   assert(timer.now > 0ns);
   // XXX TODO process delayed order requests
+  maybe_publish(timer.now);
 }
 
 void Simple::operator()(Event<Connected> const &event) {
@@ -117,7 +138,10 @@ void Simple::operator()(Event<Disconnected> const &event) {
   for (auto &[name, account] : source.accounts) {
     account.has_download_orders = {};
   }
-  auto callback = [&](auto &instrument) { instrument(event); };
+  auto callback = [&](auto &instrument) {
+    instrument(event);
+    reset(instrument);
+  };
   get_instruments_by_source(event, callback);
   // XXX TODO maybe cancel working orders on other sources?
 }
@@ -192,7 +216,10 @@ void Simple::operator()(Event<GatewayStatus> const &event) {
 
 void Simple::operator()(Event<ReferenceData> const &event) {
   check(event);
-  auto callback = [&](auto &instrument) { instrument(event); };
+  auto callback = [&](auto &instrument) {
+    instrument(event);
+    instrument_state_.update(get_index(instrument), instrument);
+  };
   get_instrument(event, callback);
 }
 
@@ -200,7 +227,7 @@ void Simple::operator()(Event<MarketStatus> const &event) {
   check(event);
   auto callback = [&](auto &instrument) {
     if (instrument(event)) {
-      update(event);
+      update(event, instrument);
     }
   };
   get_instrument(event, callback);
@@ -210,7 +237,7 @@ void Simple::operator()(Event<TopOfBook> const &event) {
   check(event);
   auto callback = [&](auto &instrument) {
     if (instrument(event)) {
-      update(event);
+      update(event, instrument);
     }
   };
   get_instrument(event, callback);
@@ -220,7 +247,7 @@ void Simple::operator()(Event<MarketByPriceUpdate> const &event) {
   check(event);
   auto callback = [&](auto &instrument) {
     if (instrument(event)) {
-      update(event);
+      update(event, instrument);
     }
   };
   get_instrument(event, callback);
@@ -230,7 +257,7 @@ void Simple::operator()(Event<MarketByOrderUpdate> const &event) {
   check(event);
   auto callback = [&](auto &instrument) {
     if (instrument(event)) {
-      update(event);
+      update(event, instrument);
     }
   };
   get_instrument(event, callback);
@@ -292,17 +319,19 @@ void Simple::operator()(Event<OrderUpdate> const &event, cache::Order const &) {
         case INCREMENTAL: {
           // note! gateway has received an order update directly from the exchange
           assert(source.ready);
+          auto index = get_index(instrument);
+          auto &order_state = instrument_state_.order_states[index];
           if (is_order_complete) {
-            assert(instrument.order_state != OrderState::IDLE);
-            instrument.reset();
+            assert(order_state != OrderState::IDLE);
+            reset(instrument);
           } else {
-            switch (instrument.order_state) {
+            switch (order_state) {
               using enum OrderState;
               case IDLE:
                 assert(false);
                 break;
               case CREATE:
-                instrument.order_state = OrderState::WORKING;
+                order_state = OrderState::WORKING;
                 assert(instrument.order_id);
                 break;
               case WORKING:
@@ -329,14 +358,20 @@ void Simple::operator()(Event<OrderUpdate> const &event, cache::Order const &) {
 void Simple::operator()(Event<TradeUpdate> const &event, cache::Order const &) {
   check(event);
   if (is_mine(event)) {
-    auto callback = [&]([[maybe_unused]] auto &account, auto &instrument) { instrument(event); };
+    auto callback = [&]([[maybe_unused]] auto &account, auto &instrument) {
+      instrument(event);
+      instrument_state_.update(get_index(instrument), instrument);
+    };
     get_account_and_instrument(event, callback);
   }
 }
 
 void Simple::operator()(Event<PositionUpdate> const &event) {
   check(event);
-  auto callback = [&]([[maybe_unused]] auto &account, auto &instrument) { instrument(event); };
+  auto callback = [&]([[maybe_unused]] auto &account, auto &instrument) {
+    instrument(event);
+    instrument_state_.update(get_index(instrument), instrument);
+  };
   get_account_and_instrument(event, callback);
 }
 
@@ -358,13 +393,10 @@ void Simple::get_instruments_by_source(MessageInfo const &message_info, Callback
   if (message_info.source >= std::size(sources_)) [[unlikely]] {
     log::fatal(R"(Unexpected: source={})"sv, message_info.source);
   }
-  auto &source = sources_[message_info.source];
-  for (auto &[exchange, tmp] : source.instruments) {
-    for (auto &[symbol, index] : tmp) {
-      auto &instrument = instruments_[index];
-      callback(instrument);
-    }
-  }
+  instrument_index_.get_by_source(message_info.source, [&](auto index) {
+    auto &instrument = instruments_[index];
+    callback(instrument);
+  });
 }
 
 template <typename T, typename Callback>
@@ -373,17 +405,11 @@ bool Simple::get_instrument(Event<T> const &event, Callback callback) {
   if (message_info.source >= std::size(sources_)) [[unlikely]] {
     log::fatal(R"(Unexpected: source={})"sv, message_info.source);
   }
-  auto &source = sources_[message_info.source];
-  auto iter_1 = source.instruments.find(value.exchange);
-  if (iter_1 == std::end(source.instruments)) {
-    return false;
-  }
-  auto &tmp = (*iter_1).second;
-  auto iter_2 = tmp.find(value.symbol);
-  if (iter_2 == std::end(tmp)) {
+  auto index = instrument_index_.find(message_info.source, value.exchange, value.symbol);
+  if (index == InstrumentIndex::NOT_FOUND) {
     return false;
   }
-  auto &instrument = instruments_[(*iter_2).second];
+  auto &instrument = instruments_[index];
   callback(instrument);
   return true;
 }
@@ -400,16 +426,11 @@ bool Simple::get_account_and_instrument(Event<T> const &event, Callback callback
     return false;
   }
   auto &account = (*iter_1).second;
-  auto iter_2 = source.instruments.find(value.exchange);
-  if (iter_2 == std::end(source.instruments)) {
+  auto index = instrument_index_.find(message_info.source, value.exchange, value.symbol);
+  if (index == InstrumentIndex::NOT_FOUND) {
     return false;
   }
-  auto &tmp = (*iter_2).second;
-  auto iter_3 = tmp.find(value.symbol);
-  if (iter_3 == std::end(tmp)) {
-    return false;
-  }
-  auto &instrument = instruments_[(*iter_3).second];
+  auto &instrument = instruments_[index];
   callback(account, instrument);
   return true;
 }
@@ -434,25 +455,40 @@ void Simple::update(MessageInfo const &message_info) {
     log::debug("instrument[{}]={}"sv, i, instruments_[i]);
     // XXX FIXME TODO check order state => maybe cancel or timeout?
   }
+  // note! hot state only (the instruments are not touched unless a spread triggers)
   for (size_t i = 0; i < (std::size(instruments_) - 1); ++i) {
-    auto &lhs = instruments_[i];
-    if (lhs.is_ready(message_info, max_age_)) {
+    if (instrument_state_.is_ready(i, message_info, max_age_)) {
       for (size_t j = i + 1; j < std::size(instruments_); ++j) {
-        auto &rhs = instruments_[j];
-        if (rhs.is_ready(message_info, max_age_)) {
-          check_spread(message_info, lhs, rhs);
+        if (instrument_state_.is_ready(j, message_info, max_age_)) {
+          check_spread(message_info, i, j);
         }
       }
     }
   }
-  for (auto &item : instruments_) {
-    publish_statistics(item);
+  maybe_publish(message_info.receive_time);
+}
+
+void Simple::update(MessageInfo const &message_info, Instrument &instrument) {
+  log::debug("instrument={}"sv, instrument);
+  auto index = get_index(instrument);
+  instrument_state_.update(index, instrument);
+  auto [bid_price, ask_price] = instrument_state_.get_best(index);
+  spread_matrix_.update(index, bid_price, ask_price);
+  if (instrument_state_.is_ready(index, message_info, max_age_)) {
+    spread_engine_.update(index, bid_price, ask_price);
+    check_best_spread(message_info, index);
+  } else {
+    spread_engine_.reset(index);
   }
+  mark_dirty(instrument);
+  maybe_publish(message_info.receive_time);
 }
 
-void Simple::check_spread(MessageInfo const &message_info, Instrument &lhs, Instrument &rhs) {
-  auto [bid_0, ask_0] = lhs.get_best();
-  auto [bid_1, ask_1] = rhs.get_best();
+void Simple::check_spread(MessageInfo const &message_info, size_t lhs_index, size_t rhs_index) {
+  auto [bid_0, ask_0] = instrument_state_.get_best(lhs_index);
+  auto [bid_1, ask_1] = instrument_state_.get_best(rhs_index);
+  auto &lhs = instruments_[lhs_index];
+  auto &rhs = instruments_[rhs_index];
   auto spread_0 = bid_0 - ask_1;  // note! sell(lhs), buy(rhs)
   auto spread_1 = bid_1 - ask_0;  // note! buy(lhs), sell(rhs)
   auto trigger_0 = threshold_ < spread_0;
@@ -477,11 +513,56 @@ void Simple::check_spread(MessageInfo const &message_info, Instrument &lhs, Inst
   }
 }
 
+// note! only the best counter-party (each direction) can trigger, O(log n)
+void Simple::check_best_spread(MessageInfo const &message_info, size_t index) {
+  auto &lhs = instruments_[index];
+  auto [bid_0, ask_0] = instrument_state_.get_best(index);
+  // note! sell(lhs), buy(rhs) => the counter-party with the lowest ask
+  auto rhs_0 = find_ready(message_info, index, [&](auto index) { return spread_engine_.find_min_ask(index); });
+  if (rhs_0 != nullptr) {
+    auto &rhs = *rhs_0;
+    auto spread_0 = bid_0 - spread_engine_.get_ask_price(get_index(rhs));
+    log::debug("SPREAD [{}:{}:{}][{}:{}:{}] {}"sv, lhs.source, lhs.exchange, lhs.symbol, rhs.source, rhs.exchange, rhs.symbol, spread_0);
+    if (threshold_ < spread_0) {
+      maybe_trade_spread(message_info, Side::SELL, lhs, rhs);
+    }
+  }
+  if (instrument_state_.order_states[index] != OrderState::IDLE) {
+    return;
+  }
+  // note! buy(lhs), sell(rhs) => the counter-party with the highest bid
+  auto rhs_1 = find_ready(message_info, index, [&](auto index) { return spread_engine_.find_max_bid(index); });
+  if (rhs_1 != nullptr) {
+    auto &rhs = *rhs_1;
+    auto spread_1 = spread_engine_.get_bid_price(get_index(rhs)) - ask_0;
+    log::debug("SPREAD [{}:{}:{}][{}:{}:{}] {}"sv, rhs.source, rhs.exchange, rhs.symbol, lhs.source, lhs.exchange, lhs.symbol, spread_1);
+    if (threshold_ < spread_1) {
+      maybe_trade_spread(message_info, Side::BUY, lhs, rhs);
+    }
+  }
+}
+
+// note! lazy, instruments no longer ready are removed from the spread engine (re-inserted by their next update)
+template <typename Find>
+Instrument *Simple::find_ready(MessageInfo const &message_info, size_t index, Find find) {
+  for (;;) {
+    auto other = find(index);
+    if (other == SpreadEngine::NOT_FOUND) {
+      return nullptr;
+    }
+    if (instrument_state_.is_ready(other, message_info, max_age_)) {
+      return &instruments_[other];
+    }
+    spread_engine_.reset(other);
+  }
+}
+
 void Simple::maybe_trade_spread(MessageInfo const &, Side side, Instrument &lhs, Instrument &rhs) {
   auto helper = [this](auto side, auto &instrument) -> bool {
-    assert(instrument.order_state == OrderState::IDLE);
+    auto &order_state = instrument_state_.order_states[get_index(instrument)];
+    assert(order_state == OrderState::IDLE);
     assert(instrument.order_id == 0);
-    instrument.order_state = OrderState::CREATE;
+    order_state = OrderState::CREATE;
     instrument.order_id = ++max_order_id_;
     auto quantity = 1.0;                                                                 // XXX FIXME TODO compute quantity
     auto price = utils::price_from_side(instrument.top_of_book(), utils::invert(side));  // note! aggress liquidity on other side
@@ -512,7 +593,7 @@ void Simple::maybe_trade_spread(MessageInfo const &, Side side, Instrument &lhs,
       dispatcher_.send(create_order, instrument.source);
       // XXX FIXME TODO record timestamp (or something like that) so we can manage rate-limitations
     } catch (NotReady &) {
-      instrument.reset();
+      reset(instrument);
       return false;
     }
     return true;
@@ -526,8 +607,8 @@ void Simple::maybe_trade_spread(MessageInfo const &, Side side, Instrument &lhs,
   }
 }
 
-bool Simple::can_trade(Side side, Instrument &instrument) const {
-  auto position = instrument.current_position();
+bool Simple::can_trade(Side side, Instrument const &instrument) const {
+  auto position = instrument_state_.positions[get_index(instrument)];
   auto position_0 = position;  // XXX FIXME TODO scale to base of instrument[0]
   switch (side) {
     using enum Side;
@@ -542,6 +623,15 @@ bool Simple::can_trade(Side side, Instrument &instrument) const {
   return false;
 }
 
+void Simple::reset(Instrument &instrument) {
+  instrument.reset();
+  auto index = get_index(instrument);
+  instrument_state_.reset(index);
+  // note! eligible again (the spread engine could have excluded the instrument while the order was working)
+  auto [bid_price, ask_price] = instrument_state_.get_best(index);
+  spread_engine_.update(index, bid_price, ask_price);
+}
+
 template <typename T>
 bool Simple::is_mine(Event<T> const &event) const {
   auto &[message_info, value] = event;
@@ -562,48 +652,48 @@ void Simple::check(Event<T> const &event) {
   time_checker_(event);
 }
 
-// XXX FIXME TODO proper (for now, just testing simulator support)
+void Simple::mark_dirty(Instrument const &instrument) {
+  auto index = get_index(instrument);
+  if (!is_dirty_[index]) {
+    is_dirty_[index] = true;
+    dirty_.emplace_back(index);
+  }
+}
+
+void Simple::maybe_publish(std::chrono::nanoseconds now) {
+  if (std::empty(dirty_) || now < next_publish_) {
+    return;
+  }
+  next_publish_ = now + publish_interval_;
+  for (auto index : dirty_) {
+    is_dirty_[index] = false;
+    publish_statistics(instruments_[index]);
+  }
+  dirty_.clear();
+  publish_spreads();
+}
+
 // NOLINTBEGIN(readability-magic-numbers)
-void Simple::publish_statistics(Instrument &instrument) {
+// XXX FIXME TODO proper (for now, just testing simulator support)
+void Simple::publish_statistics(Instrument const &instrument) {
   auto &top_of_book = instrument.top_of_book();
-  std::array<Measurement, 4> measurements{{
-      {
-          .name = "bp"sv,
-          .value = top_of_book.bid_price,
-      },
-      {
-          .name = "bq"sv,
-          .value = top_of_book.bid_quantity,
-      },
-      {
-          .name = "ap"sv,
-          .value = top_of_book.ask_price,
-      },
-      {
-          .name = "aq"sv,
-          .value = top_of_book.ask_quantity,
-      },
-  }};
+  measurements_[0].value = top_of_book.bid_price;
+  measurements_[1].value = top_of_book.bid_quantity;
+  measurements_[2].value = top_of_book.ask_price;
+  measurements_[3].value = top_of_book.ask_quantity;
   auto custom_metrics = CustomMetrics{
       .label = "top_of_book"sv,
       .account = instrument.account,
       .exchange = instrument.exchange,
       .symbol = instrument.symbol,
-      .measurements = measurements,
+      .measurements = measurements_,
       .update_type = UpdateType::INCREMENTAL,
   };
   dispatcher_.send(custom_metrics, publish_source_);
-  //
-  std::array<MatrixKey, 2> headers{{
-      "0"sv,
-      "1"sv,
-  }};
-  std::array<double, 4> data{{
-      0.0,
-      1.1,
-      2.2,
-      3.3,
-  }};
+}
+
+void Simple::publish_spreads() {
+  auto headers = spread_matrix_.get_headers();
   auto custom_matrix = CustomMatrix{
       .label = "spreads"sv,
       .account = {},
@@ -611,7 +701,7 @@ void Simple::publish_statistics(Instrument &instrument) {
       .symbol = {},
       .rows = headers,
       .columns = headers,
-      .data = data,
+      .data = spread_matrix_.get_data(),
       .update_type = UpdateType::INCREMENTAL,
       .version = {},
   };
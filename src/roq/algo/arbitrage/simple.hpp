@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "roq/utils/container.hpp"
@@ -16,7 +17,11 @@
 #include "roq/algo/strategy/config.hpp"
 
 #include "roq/algo/arbitrage/instrument.hpp"
+#include "roq/algo/arbitrage/instrument_index.hpp"
+#include "roq/algo/arbitrage/instrument_state.hpp"
 #include "roq/algo/arbitrage/parameters.hpp"
+#include "roq/algo/arbitrage/spread_engine.hpp"
+#include "roq/algo/arbitrage/spread_matrix.hpp"
 
 namespace roq {
 namespace algo {
@@ -88,11 +93,23 @@ struct Simple final : public Strategy {
 
   void update(MessageInfo const &);
 
-  void check_spread(MessageInfo const &, Instrument &lhs, Instrument &rhs);
+  // note! incremental (only pairs involving the updated instrument)
+  void update(MessageInfo const &, Instrument &);
+
+  void check_spread(MessageInfo const &, size_t lhs, size_t rhs);
+
+  void check_best_spread(MessageInfo const &, size_t index);
+
+  template <typename Find>
+  Instrument *find_ready(MessageInfo const &, size_t index, Find);
+
+  size_t get_index(Instrument const &instrument) const { return static_cast<size_t>(&instrument - std::data(instruments_)); }
 
   void maybe_trade_spread(MessageInfo const &, Side, Instrument &lhs, Instrument &rhs);
 
-  bool can_trade(Side, Instrument &) const;
+  bool can_trade(Side, Instrument const &) const;
+
+  void reset(Instrument &);
 
   struct Order final {
     Side side = {};
@@ -107,7 +124,6 @@ struct Simple final : public Strategy {
 
   struct Source final {
     utils::unordered_map<std::string_view, Account> accounts;
-    utils::unordered_map<std::string_view, utils::unordered_map<std::string_view, size_t>> const instruments;
     bool ready = {};
     std::vector<std::chrono::nanoseconds> stream_latency;
     utils::unordered_map<uint64_t, Order> working_orders;
@@ -122,7 +138,13 @@ struct Simple final : public Strategy {
   template <typename T>
   bool is_mine(Event<T> const &) const;
 
-  void publish_statistics(Instrument &);
+  void mark_dirty(Instrument const &);
+
+  // note! conflated, only instruments updated since the last publish
+  void maybe_publish(std::chrono::nanoseconds now);
+
+  void publish_statistics(Instrument const &);
+  void publish_spreads();
 
  private:
   Dispatcher &dispatcher_;
@@ -133,11 +155,21 @@ struct Simple final : public Strategy {
   double const min_position_0_;
   double const max_position_0_;
   uint8_t const publish_source_;
+  std::chrono::nanoseconds const publish_interval_;
   SupportType const market_data_type_;
   OrderCache &order_cache_;
   std::vector<Instrument> instruments_;
+  InstrumentIndex const instrument_index_;
+  InstrumentState instrument_state_;
+  SpreadEngine spread_engine_;
   std::vector<Source> sources_;
   uint64_t max_order_id_ = {};
+  // publish
+  std::chrono::nanoseconds next_publish_ = {};
+  std::vector<bool> is_dirty_;
+  std::vector<size_t> dirty_;
+  std::array<Measurement, 4> measurements_;
+  SpreadMatrix spread_matrix_;
   // DEBUG
   tools::TimeChecker time_checker_;
 };
@@ -0,0 +1,100 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/arbitrage/spread_engine.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <functional>
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// === HELPERS ===
+
+namespace {
+auto const INF = std::numeric_limits<double>::infinity();
+
+auto create_tree(auto capacity) {
+  std::vector<size_t> result(2 * capacity, SpreadEngine::NOT_FOUND);
+  for (size_t i = 0; i < capacity; ++i) {
+    result[capacity + i] = i;
+  }
+  return result;
+}
+
+// note! ties are resolved by the lower index (deterministic)
+template <typename Compare>
+size_t select(std::vector<double> const &prices, size_t lhs, size_t rhs, Compare compare) {
+  if (lhs == SpreadEngine::NOT_FOUND) {
+    return rhs;
+  }
+  if (rhs == SpreadEngine::NOT_FOUND) {
+    return lhs;
+  }
+  if (compare(prices[rhs], prices[lhs])) {
+    return rhs;
+  }
+  if (compare(prices[lhs], prices[rhs])) {
+    return lhs;
+  }
+  return std::min(lhs, rhs);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+SpreadEngine::SpreadEngine(size_t size)
+    : size_{size}, capacity_{std::bit_ceil(std::max<size_t>(size, 1))}, bid_prices_(capacity_, -INF), ask_prices_(capacity_, INF),
+      max_bid_{create_tree(capacity_)}, min_ask_{create_tree(capacity_)} {
+  for (size_t i = capacity_ - 1; i > 0; --i) {
+    max_bid_[i] = select(bid_prices_, max_bid_[2 * i], max_bid_[2 * i + 1], std::greater<double>{});
+    min_ask_[i] = select(ask_prices_, min_ask_[2 * i], min_ask_[2 * i + 1], std::less<double>{});
+  }
+}
+
+void SpreadEngine::update(size_t index, double bid_price, double ask_price) {
+  assert(index < size_);
+  bid_prices_[index] = std::isnan(bid_price) ? -INF : bid_price;
+  ask_prices_[index] = std::isnan(ask_price) ? INF : ask_price;
+  update_tree(max_bid_, bid_prices_, capacity_, index, std::greater<double>{});
+  update_tree(min_ask_, ask_prices_, capacity_, index, std::less<double>{});
+}
+
+size_t SpreadEngine::find_max_bid(size_t exclude) const {
+  auto result = find_tree(max_bid_, bid_prices_, capacity_, exclude, std::greater<double>{});
+  return (result == NOT_FOUND || std::isinf(bid_prices_[result])) ? NOT_FOUND : result;
+}
+
+size_t SpreadEngine::find_min_ask(size_t exclude) const {
+  auto result = find_tree(min_ask_, ask_prices_, capacity_, exclude, std::less<double>{});
+  return (result == NOT_FOUND || std::isinf(ask_prices_[result])) ? NOT_FOUND : result;
+}
+
+template <typename Compare>
+void SpreadEngine::update_tree(std::vector<size_t> &tree, std::vector<double> const &prices, size_t capacity, size_t index, Compare compare) {
+  for (auto node = (capacity + index) / 2; node > 0; node /= 2) {
+    tree[node] = select(prices, tree[2 * node], tree[2 * node + 1], compare);
+  }
+}
+
+// note! the winner of each sibling along the path from the excluded leaf to the root
+template <typename Compare>
+size_t SpreadEngine::find_tree(std::vector<size_t> const &tree, std::vector<double> const &prices, size_t capacity, size_t exclude, Compare compare) {
+  if (tree[1] != exclude) {
+    return tree[1];  // note! fast path
+  }
+  auto result = NOT_FOUND;
+  for (auto node = capacity + exclude; node > 1; node /= 2) {
+    result = select(prices, result, tree[node ^ 1], compare);
+  }
+  return result;
+}
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
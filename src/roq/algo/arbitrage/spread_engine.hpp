@@ -0,0 +1,63 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "roq/limits.hpp"
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// spread engine
+//
+// tournament trees (max bid and min ask) over the instrument index
+// - update is O(log n), only the path from the updated leaf to the root is re-evaluated
+// - the best counter-party for an instrument (excluding itself) is found in O(log n)
+//
+// note! unavailable prices (e.g. instrument not ready) are represented as -inf (bid) and +inf (ask)
+
+struct SpreadEngine final {
+  static constexpr size_t const NOT_FOUND = std::numeric_limits<size_t>::max();
+
+  explicit SpreadEngine(size_t size);
+
+  SpreadEngine(SpreadEngine &&) = default;
+  SpreadEngine(SpreadEngine const &) = delete;
+
+  size_t size() const { return size_; }
+
+  double get_bid_price(size_t index) const { return bid_prices_[index]; }
+  double get_ask_price(size_t index) const { return ask_prices_[index]; }
+
+  // note! NaN => unavailable
+  void update(size_t index, double bid_price, double ask_price);
+
+  void reset(size_t index) { update(index, NaN, NaN); }
+
+  // note! returns NOT_FOUND if no other instrument has a price
+  size_t find_max_bid(size_t exclude) const;
+  size_t find_min_ask(size_t exclude) const;
+
+ protected:
+  template <typename Compare>
+  static void update_tree(std::vector<size_t> &tree, std::vector<double> const &prices, size_t capacity, size_t index, Compare);
+
+  template <typename Compare>
+  static size_t find_tree(std::vector<size_t> const &tree, std::vector<double> const &prices, size_t capacity, size_t exclude, Compare);
+
+ private:
+  size_t const size_;
+  size_t const capacity_;  // note! power of 2
+  std::vector<double> bid_prices_;
+  std::vector<double> ask_prices_;
+  // note! winner (index) of each node, leaves are at [capacity, 2 * capacity)
+  std::vector<size_t> max_bid_;
+  std::vector<size_t> min_ask_;
+};
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,66 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/arbitrage/spread_matrix.hpp"
+
+#include <fmt/format.h>
+
+#include <cassert>
+
+#include "roq/limits.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// === HELPERS ===
+
+namespace {
+template <typename R>
+auto create_headers(auto &instruments) {
+  using result_type = std::remove_cvref_t<R>;
+  result_type result;
+  result.reserve(std::size(instruments));
+  for (auto &item : instruments) {
+    result.emplace_back(fmt::format("{}:{}"sv, item.exchange, item.symbol));
+  }
+  return result;
+}
+
+// note! contiguous (vectorized)
+void compute_row(std::span<double> const &result, double bid_price, std::span<double const> const &ask_prices) {
+  assert(std::size(result) == std::size(ask_prices));
+  for (size_t i = 0; i < std::size(result); ++i) {
+    result[i] = bid_price - ask_prices[i];
+  }
+}
+
+// note! strided output
+void compute_column(std::span<double> const &result, size_t stride, std::span<double const> const &bid_prices, double ask_price) {
+  for (size_t i = 0; i < std::size(bid_prices); ++i) {
+    result[i * stride] = bid_prices[i] - ask_price;
+  }
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+SpreadMatrix::SpreadMatrix(std::span<Instrument const> const &instruments)
+    : size_{std::size(instruments)}, bid_prices_(size_, NaN), ask_prices_(size_, NaN), headers_{create_headers<decltype(headers_)>(instruments)},
+      data_(size_ * size_, NaN) {
+}
+
+void SpreadMatrix::update(size_t index, double bid_price, double ask_price) {
+  assert(index < size_);
+  bid_prices_[index] = bid_price;
+  ask_prices_[index] = ask_price;
+  auto data = std::span{data_};
+  compute_row(data.subspan(index * size_, size_), bid_price, ask_prices_);
+  compute_column(data.subspan(index), size_, bid_prices_, ask_price);
+  data[index * size_ + index] = NaN;
+}
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,51 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/algo/arbitrage/instrument.hpp"
+
+namespace roq {
+namespace algo {
+namespace arbitrage {
+
+// spread matrix
+//
+// spread(i, j) = bid(i) - ask(j), i.e. sell instrument i and buy instrument j
+// - row-major, the diagonal is NaN
+// - an update only re-computes the row and the column of the updated instrument, O(n)
+// - headers ("exchange:symbol") and data are allocated once (published as views)
+//
+// note! unavailable prices are represented as NaN (and propagate to the spreads)
+
+struct SpreadMatrix final {
+  explicit SpreadMatrix(std::span<Instrument const> const &instruments);
+
+  SpreadMatrix(SpreadMatrix &&) = default;
+  SpreadMatrix(SpreadMatrix const &) = delete;
+
+  size_t size() const { return size_; }
+
+  double get_spread(size_t row, size_t column) const { return data_[row * size_ + column]; }
+
+  std::span<MatrixKey const> get_headers() const { return headers_; }
+  std::span<double const> get_data() const { return data_; }
+
+  // note! NaN => unavailable
+  void update(size_t index, double bid_price, double ask_price);
+
+ private:
+  size_t const size_;
+  std::vector<double> bid_prices_;
+  std::vector<double> ask_prices_;
+  std::vector<MatrixKey> const headers_;
+  std::vector<double> data_;
+};
+
+}  // namespace arbitrage
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,49 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <utility>
+
+#include "roq/algo/matcher.hpp"
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// adaptor
+//
+// note! exposes a (header-only) matcher through the virtual Matcher interface
+
+template <typename T>
+struct Adaptor final : public Matcher {
+  template <typename... Args>
+  explicit Adaptor(Args &&...args) : matcher_{std::forward<Args>(args)...} {}
+
+  Adaptor(Adaptor const &) = delete;
+
+ protected:
+  void operator()(Event<ReferenceData> const &event) override { matcher_(event); }
+  void operator()(Event<MarketStatus> const &event) override { matcher_(event); }
+
+  void operator()(Event<TopOfBook> const &event) override { matcher_(event); }
+  void operator()(Event<MarketByPriceUpdate> const &event) override { matcher_(event); }
+  void operator()(Event<MarketByOrderUpdate> const &event) override { matcher_(event); }
+  void operator()(Event<TradeSummary> const &event) override { matcher_(event); }
+  void operator()(Event<StatisticsUpdate> const &event) override { matcher_(event); }
+
+  void operator()(Event<CreateOrder> const &event, cache::Order &order) override { matcher_(event, order); }
+  void operator()(Event<ModifyOrder> const &event, cache::Order &order) override { matcher_(event, order); }
+  void operator()(Event<CancelOrder> const &event, cache::Order &order) override { matcher_(event, order); }
+
+  void operator()(Event<CancelAllOrders> const &event) override { matcher_(event); }
+
+  void operator()(Event<MassQuote> const &event) override { matcher_(event); }
+  void operator()(Event<CancelQuotes> const &event) override { matcher_(event); }
+
+ private:
+  T matcher_;
+};
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
@@ -8,8 +8,10 @@
 
 #include "roq/logging.hpp"
 
-#include "roq/algo/matcher/queue_position_simple.hpp"
-#include "roq/algo/matcher/simple.hpp"
+#include "roq/algo/matcher/basic_queue_position_simple.hpp"
+#include "roq/algo/matcher/basic_simple.hpp"
+
+#include "roq/algo/matcher/adaptor.hpp"
 
 using namespace std::literals;
 
@@ -17,15 +19,29 @@ namespace roq {
 namespace algo {
 namespace matcher {
 
+// === HELPERS ===
+
+namespace {
+template <template <typename> typename Book>
+using Simple = Adaptor<BasicSimple<Book, Matcher::Dispatcher, OrderCache>>;
+
+template <template <typename> typename Book>
+using QueuePositionSimple = Adaptor<BasicQueuePositionSimple<Book, Matcher::Dispatcher, OrderCache>>;
+}  // namespace
+
 // === IMPLEMENTATION ===
 
 std::unique_ptr<Matcher> Factory::create(Type type, Matcher::Dispatcher &dispatcher, OrderCache &order_cache, Config const &config) {
   switch (type) {
     using enum Type;
     case SIMPLE:
-      return std::make_unique<Simple>(dispatcher, order_cache, config);
+      return std::make_unique<Simple<SortedVector>>(dispatcher, order_cache, config);
     case QUEUE_POSITION_SIMPLE:
-      return std::make_unique<QueuePositionSimple>(dispatcher, order_cache, config);
+      return std::make_unique<QueuePositionSimple<SortedVector>>(dispatcher, order_cache, config);
+    case SIMPLE_PRICE_LADDER:
+      return std::make_unique<Simple<PriceLadder>>(dispatcher, order_cache, config);
+    case QUEUE_POSITION_SIMPLE_PRICE_LADDER:
+      return std::make_unique<QueuePositionSimple<PriceLadder>>(dispatcher, order_cache, config);
   }
   log::fatal("Unexpected: type={}"sv, type);
 }
@@ -0,0 +1,380 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/matcher/group.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include "roq/logging.hpp"
+
+#include "roq/utils/common.hpp"
+
+#include "roq/algo/matcher/config.hpp"
+#include "roq/algo/matcher/factory.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace matcher {
+
+// === IMPLEMENTATION ===
+
+Group::Group(Type type, Matcher::Dispatcher &dispatcher, OrderCache &order_cache, MarketDataSource market_data_source)
+    : type_{type}, dispatcher_{dispatcher}, proxy_{dispatcher}, order_cache_{order_cache}, market_data_source_{market_data_source} {
+}
+
+uint32_t Group::find(uint8_t source, std::string_view const &exchange, std::string_view const &symbol) const {
+  if (source >= std::size(ids_)) {
+    return UNDEFINED_ID;
+  }
+  auto &tmp_1 = ids_[source];
+  auto iter_1 = tmp_1.find(exchange);
+  if (iter_1 == std::end(tmp_1)) {
+    return UNDEFINED_ID;
+  }
+  auto &tmp_2 = (*iter_1).second;
+  auto iter_2 = tmp_2.find(symbol);
+  if (iter_2 == std::end(tmp_2)) {
+    return UNDEFINED_ID;
+  }
+  return (*iter_2).second;
+}
+
+uint32_t Group::intern(Event<ReferenceData> const &event) {
+  auto &[message_info, reference_data] = event;
+  ids_.resize(std::max<size_t>(message_info.source + 1, std::size(ids_)));
+  auto &tmp = ids_[message_info.source][reference_data.exchange];
+  auto iter = tmp.find(reference_data.symbol);
+  if (iter == std::end(tmp)) [[unlikely]] {
+    auto id = static_cast<uint32_t>(std::size(matchers_));
+    if (id == UNDEFINED_ID) [[unlikely]] {
+      log::fatal("Unexpected: too many instruments"sv);
+    }
+    auto config = Config{
+        .source = message_info.source,
+        .exchange = reference_data.exchange,
+        .symbol = reference_data.symbol,
+        .market_data_source = market_data_source_,
+    };
+    log::info("Create matcher (id={}, config={})"sv, id, config);
+    matchers_.emplace_back(Factory::create(type_, proxy_, order_cache_, config));
+    sources_.emplace_back(message_info.source);
+    iter = tmp.try_emplace(reference_data.symbol, id).first;
+  }
+  auto id = (*iter).second;
+  dispatch(id, event);
+  return id;
+}
+
+void Group::operator()(uint32_t id, Event<ReferenceData> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<MarketStatus> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<TopOfBook> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<MarketByPriceUpdate> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<MarketByOrderUpdate> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<TradeSummary> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<StatisticsUpdate> const &event) {
+  dispatch(id, event);
+}
+
+void Group::operator()(uint32_t id, Event<CreateOrder> const &event, cache::Order &order) {
+  dispatch(id, event, order);
+}
+
+void Group::operator()(uint32_t id, Event<ModifyOrder> const &event, cache::Order &order) {
+  dispatch(id, event, order);
+}
+
+void Group::operator()(uint32_t id, Event<CancelOrder> const &event, cache::Order &order) {
+  dispatch(id, event, order);
+}
+
+// Matcher
+
+void Group::operator()(Event<ReferenceData> const &event) {
+  intern(event);
+}
+
+void Group::operator()(Event<MarketStatus> const &event) {
+  dispatch(event.value.exchange, event.value.symbol, event);
+}
+
+void Group::operator()(Event<TopOfBook> const &event) {
+  dispatch(event.value.exchange, event.value.symbol, event);
+}
+
+void Group::operator()(Event<MarketByPriceUpdate> const &event) {
+  dispatch(event.value.exchange, event.value.symbol, event);
+}
+
+void Group::operator()(Event<MarketByOrderUpdate> const &event) {
+  dispatch(event.value.exchange, event.value.symbol, event);
+}
+
+void Group::operator()(Event<TradeSummary> const &event) {
+  dispatch(event.value.exchange, event.value.symbol, event);
+}
+
+void Group::operator()(Event<StatisticsUpdate> const &event) {
+  dispatch(event.value.exchange, event.value.symbol, event);
+}
+
+void Group::operator()(Event<CreateOrder> const &event, cache::Order &order) {
+  dispatch(event.value.exchange, event.value.symbol, event, order);
+}
+
+void Group::operator()(Event<ModifyOrder> const &event, cache::Order &order) {
+  dispatch(order.exchange, order.symbol, event, order);
+}
+
+void Group::operator()(Event<CancelOrder> const &event, cache::Order &order) {
+  dispatch(order.exchange, order.symbol, event, order);
+}
+
+// note! not bound to an instrument => the acks from all matchers are aggregated (exactly one ack, dispatched after the order updates)
+
+void Group::operator()(Event<CancelAllOrders> const &event) {
+  auto &cancel_all_orders = event.value;
+  if (std::empty(cancel_all_orders.exchange) || std::empty(cancel_all_orders.symbol)) {
+    proxy_.aggregate = true;
+    proxy_.number_of_affected_orders = {};
+    dispatch_all(event);
+    proxy_.aggregate = false;
+    dispatch_cancel_all_orders_ack(event, {}, proxy_.number_of_affected_orders);
+  } else {
+    dispatch(cancel_all_orders.exchange, cancel_all_orders.symbol, event);
+  }
+}
+
+// note! only routed to the matchers having a quote (a matcher will reject a mass quote without a quote for its instrument)
+// note! the acks from all matchers are aggregated (exactly one ack, rejected if any matcher has rejected)
+// note! atomic per instrument
+// - unknown instruments are detected before any matcher is called (the request is rejected and nothing is changed)
+// - a matcher rejecting its quote (validation) does not prevent the other matchers from applying theirs
+
+void Group::operator()(Event<MassQuote> const &event) {
+  auto &mass_quote = event.value;
+  auto is_duplicate = [&](size_t index) {
+    auto &quote = mass_quote.quotes[index];
+    for (size_t i = 0; i < index; ++i) {
+      if (mass_quote.quotes[i].exchange == quote.exchange && mass_quote.quotes[i].symbol == quote.symbol) {
+        return true;
+      }
+    }
+    return false;
+  };
+  ids_buffer_.clear();
+  for (size_t i = 0; i < std::size(mass_quote.quotes); ++i) {
+    if (is_duplicate(i)) {
+      continue;  // note! the matcher will use the last quote
+    }
+    auto &quote = mass_quote.quotes[i];
+    auto id = find(event.message_info.source, quote.exchange, quote.symbol);
+    if (id == UNDEFINED_ID) [[unlikely]] {
+      dispatch_quote_ack<MassQuoteAck>(event, Error::INVALID_SYMBOL);
+      return;
+    }
+    ids_buffer_.emplace_back(id);
+  }
+  proxy_.aggregate = true;
+  proxy_.error = {};
+  for (auto id : ids_buffer_) {
+    dispatch(id, event);
+  }
+  proxy_.aggregate = false;
+  dispatch_quote_ack<MassQuoteAck>(event, proxy_.error);
+}
+
+void Group::operator()(Event<CancelQuotes> const &event) {
+  auto &cancel_quotes = event.value;
+  if (std::empty(cancel_quotes.exchange) || std::empty(cancel_quotes.symbol)) {
+    proxy_.aggregate = true;
+    proxy_.error = {};
+    dispatch_all(event);
+    proxy_.aggregate = false;
+    dispatch_quote_ack<CancelQuotesAck>(event, proxy_.error);
+  } else {
+    dispatch(cancel_quotes.exchange, cancel_quotes.symbol, event);
+  }
+}
+
+template <typename T, typename... Args>
+void Group::dispatch(uint32_t id, Event<T> const &event, Args &&...args) {
+  assert(id < std::size(matchers_));
+  (*matchers_[id])(event, std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+void Group::dispatch(std::string_view const &exchange, std::string_view const &symbol, Event<T> const &event, Args &&...args) {
+  auto id = find(event.message_info.source, exchange, symbol);
+  if (id == UNDEFINED_ID) [[unlikely]] {
+    // note! unknown instrument => requests are rejected, market data is dropped
+    if constexpr (sizeof...(Args) > 0) {
+      dispatch_order_ack(event, std::forward<Args>(args)..., Error::INVALID_SYMBOL);
+    } else if constexpr (std::is_same_v<T, CancelAllOrders>) {
+      dispatch_cancel_all_orders_ack(event, Error::INVALID_SYMBOL, 0);
+    } else if constexpr (std::is_same_v<T, CancelQuotes>) {
+      dispatch_quote_ack<CancelQuotesAck>(event, Error::INVALID_SYMBOL);
+    }
+    return;
+  }
+  dispatch(id, event, std::forward<Args>(args)...);
+}
+
+template <typename T>
+void Group::dispatch_all(Event<T> const &event) {
+  for (size_t id = 0; id < std::size(matchers_); ++id) {
+    if (sources_[id] == event.message_info.source) {
+      (*matchers_[id])(event);
+    }
+  }
+}
+
+template <typename T>
+void Group::dispatch_order_ack(Event<T> const &event, cache::Order const &order, Error error) {
+  auto &[message_info, value] = event;
+  auto order_ack = OrderAck{
+      .account = order.account,
+      .order_id = order.order_id,
+      .exchange = order.exchange,
+      .symbol = order.symbol,
+      .side = order.side,
+      .position_effect = order.position_effect,
+      .margin_mode = order.margin_mode,
+      .quantity_type = order.quantity_type,
+      .request_type = utils::get_request_type<decltype(value)>(),
+      .origin = Origin::EXCHANGE,
+      .request_status = RequestStatus::REJECTED,
+      .error = error,
+      .text = magic_enum::enum_name(error),
+      .request_id = {},
+      .external_account = {},
+      .external_order_id = {},
+      .client_order_id = {},
+      .quantity = order.quantity,
+      .price = order.price,
+      .stop_price = order.stop_price,
+      .leverage = order.leverage,
+      .routing_id = {},
+      .version = utils::get_version(value),
+      .risk_exposure = NaN,
+      .risk_exposure_change = NaN,
+      .traded_quantity = order.traded_quantity,
+      .round_trip_latency = {},
+      .user = {},
+  };
+  create_event_and_dispatch(dispatcher_, message_info, order_ack);
+}
+
+void Group::dispatch_cancel_all_orders_ack(Event<CancelAllOrders> const &event, Error error, uint32_t number_of_affected_orders) {
+  auto &[message_info, cancel_all_orders] = event;
+  auto get_text = [&]() -> std::string_view {
+    if (error != Error{}) {
+      return magic_enum::enum_name(error);
+    }
+    return {};
+  };
+  // note! echo the request (not bound to a single matcher)
+  auto cancel_all_orders_ack = CancelAllOrdersAck{
+      .account = cancel_all_orders.account,
+      .order_id = cancel_all_orders.order_id,
+      .exchange = cancel_all_orders.exchange,
+      .symbol = cancel_all_orders.symbol,
+      .side = cancel_all_orders.side,
+      .origin = Origin::EXCHANGE,
+      .request_status = error != Error{} ? RequestStatus::REJECTED : RequestStatus::ACCEPTED,
+      .error = error,
+      .text = get_text(),
+      .number_of_affected_orders = number_of_affected_orders,
+      .strategy_id = cancel_all_orders.strategy_id,
+  };
+  create_event_and_dispatch(dispatcher_, message_info, cancel_all_orders_ack);
+}
+
+template <typename R, typename T>
+void Group::dispatch_quote_ack(Event<T> const &event, Error error) {
+  auto &[message_info, value] = event;
+  auto get_text = [&]() -> std::string_view {
+    if (error != Error{}) {
+      return magic_enum::enum_name(error);
+    }
+    return {};
+  };
+  // note! echo the request (a mass quote is not bound to a single instrument)
+  auto get_instrument = [&]() -> std::pair<std::string_view, std::string_view> {
+    if constexpr (std::is_same_v<T, MassQuote>) {
+      if (std::size(value.quotes) == 1) {
+        return {value.quotes[0].exchange, value.quotes[0].symbol};
+      }
+      return {};
+    } else {
+      return {value.exchange, value.symbol};
+    }
+  };
+  auto [exchange, symbol] = get_instrument();
+  auto quote_ack = R{
+      .account = value.account,
+      .quote_id = value.quote_id,
+      .exchange = exchange,
+      .symbol = symbol,
+      .origin = Origin::EXCHANGE,
+      .request_status = error != Error{} ? RequestStatus::REJECTED : RequestStatus::ACCEPTED,
+      .error = error,
+      .text = get_text(),
+  };
+  create_event_and_dispatch(dispatcher_, message_info, quote_ack);
+}
+
+// Proxy
+
+void Group::Proxy::operator()(Event<CancelAllOrdersAck> const &event) {
+  if (!aggregate) {
+    dispatcher_(event);
+    return;
+  }
+  auto &cancel_all_orders_ack = event.value;
+  if (cancel_all_orders_ack.request_status == RequestStatus::ACCEPTED) {
+    number_of_affected_orders += cancel_all_orders_ack.number_of_affected_orders;
+  }
+}
+
+void Group::Proxy::operator()(Event<MassQuoteAck> const &event) {
+  if (!aggregate) {
+    dispatcher_(event);
+    return;
+  }
+  update_error(event.value.error);
+}
+
+void Group::Proxy::operator()(Event<CancelQuotesAck> const &event) {
+  if (!aggregate) {
+    dispatcher_(event);
+    return;
+  }
+  update_error(event.value.error);
+}
+
+}  // namespace matcher
+}  // namespace algo
+}  // namespace roq
@@ -69,10 +69,55 @@ void parse_accounts(auto &accounts, auto &node) {
   }
 }
 
+void parse_latency(auto &latency, auto &node) {
+  enum class Key {
+    BASE_NS,
+    JITTER_NS,
+    TAIL_PROBABILITY,
+    TAIL_SCALE_NS,
+    TAIL_SHAPE,
+    TAIL_MAX_NS,
+  };
+  auto table = node.as_table();
+  for (auto &[key, value] : *table) {
+    auto key_2 = utils::parse_enum<Key>(key);
+    switch (key_2) {
+      case Key::BASE_NS:
+        latency.base = std::chrono::nanoseconds{value.template value<int64_t>().value()};
+        break;
+      case Key::JITTER_NS:
+        latency.jitter = std::chrono::nanoseconds{value.template value<int64_t>().value()};
+        break;
+      case Key::TAIL_PROBABILITY:
+        latency.tail_probability = value.template value<double>().value();
+        break;
+      case Key::TAIL_SCALE_NS:
+        latency.tail_scale = std::chrono::nanoseconds{value.template value<int64_t>().value()};
+        break;
+      case Key::TAIL_SHAPE:
+        latency.tail_shape = value.template value<double>().value();
+        break;
+      case Key::TAIL_MAX_NS:
+        latency.tail_max = std::chrono::nanoseconds{value.template value<int64_t>().value()};
+        break;
+    }
+  }
+  if (latency.base.count() < 0 || latency.jitter.count() < 0 || latency.tail_scale.count() < 0 || latency.tail_max.count() < 0) {
+    throw RuntimeError{"Latencies can not be negative"sv};
+  }
+  if (latency.tail_probability < 0.0 || latency.tail_probability > 1.0) {
+    throw RuntimeError{"'tail_probability' must be in the range [0, 1]"sv};
+  }
+  if (!(latency.tail_shape >= Latency::MIN_TAIL_SHAPE)) {
+    throw RuntimeError{"'tail_shape' must be at least {}"sv, Latency::MIN_TAIL_SHAPE};
+  }
+}
+
 void parse_sources(auto &sources, auto &node) {
   enum class Key {
     MARKET_DATA_LATENCY_MS,
-    ORDER_MANAGEMENT_LATENCY_MS,
+    ORDER_MANAGEMENT_LATENCY_MS,  // note! fixed (base of the distribution)
+    ORDER_MANAGEMENT_LATENCY,
     ACCOUNTS,
   };
   auto arr = node.as_array();
@@ -90,6 +135,19 @@ void parse_sources(auto &sources, auto &node) {
         case Key::ORDER_MANAGEMENT_LATENCY_MS: {
           auto tmp = value.template value<uint32_t>().value();
           source.order_management_latency = std::chrono::milliseconds{tmp};
+          source.order_management_latency_distribution.base = source.order_management_latency;
+          break;
+        }
+        case Key::ORDER_MANAGEMENT_LATENCY: {
+          auto &latency = source.order_management_latency_distribution;
+          parse_latency(latency, value);
+          source.order_management_latency = std::chrono::duration_cast<std::chrono::milliseconds>(latency.base);
+          if (source.order_management_latency != latency.base) {
+            log::warn(
+                "Fixed order management latency has been truncated (base={}, order_management_latency={}) => only the distribution is exact"sv,
+                latency.base,
+                source.order_management_latency);
+          }
           break;
         }
         case Key::ACCOUNTS:
@@ -140,6 +198,15 @@ Config Config::parse_text(std::string_view const &text) {
   return parse_helper(root);
 }
 
+std::vector<Latency> Config::get_order_management_latency() const {
+  std::vector<Latency> result;
+  result.reserve(std::size(sources));
+  for (auto &item : sources) {
+    result.emplace_back(item.order_management_latency_distribution);
+  }
+  return result;
+}
+
 // NOLINTEND(bugprone-unchecked-optional-access)
 
 }  // namespace simulator
@@ -0,0 +1,331 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "roq/api.hpp"
+#include "roq/exceptions.hpp"
+
+#include "roq/utils/container.hpp"
+
+namespace roq {
+namespace algo {
+namespace simulator {
+namespace event_log {
+
+// event log (binary format)
+//
+// file header followed by records, each record is a header followed by the encoded message
+// - all records are padded to 8 bytes (the alignment of the decoded arrays)
+// - strings are encoded as length followed by the characters (decoded as views)
+// - arrays of plain types (e.g. MBPUpdate) are encoded using the native layout (decoded as views)
+// - arrays of types containing views (e.g. Trade) are encoded element by element (decoded into a re-used buffer)
+// - source names are only recorded once (a separate record) and are decoded as views
+//
+// note! the native layout is used, files are therefore not portable between platforms (or API versions)
+
+uint64_t const MAGIC = 0x314f474c41514f52;  // "ROQALGO1" (little-endian)
+uint32_t const VERSION = 1;
+size_t const ALIGNMENT = 8;
+
+enum class RecordType : uint8_t {
+  UNDEFINED,
+  SOURCE,
+  REFERENCE_DATA,
+  MARKET_STATUS,
+  TOP_OF_BOOK,
+  MARKET_BY_PRICE_UPDATE,
+  MARKET_BY_ORDER_UPDATE,
+  TRADE_SUMMARY,
+};
+
+struct FileHeader final {
+  uint64_t magic = {};
+  uint32_t version = {};
+  uint32_t reserved = {};
+};
+
+static_assert(sizeof(FileHeader) % ALIGNMENT == 0);
+
+struct RecordHeader final {
+  uint32_t length = {};  // note! including the header
+  RecordType type = {};
+  uint8_t source = {};
+  uint16_t reserved = {};
+  uint64_t source_seqno = {};
+  int64_t receive_time = {};
+  int64_t receive_time_utc = {};
+};
+
+static_assert(sizeof(RecordHeader) % ALIGNMENT == 0);
+
+template <typename T>
+constexpr RecordType get_record_type() {
+  if constexpr (std::is_same_v<T, ReferenceData>) {
+    return RecordType::REFERENCE_DATA;
+  } else if constexpr (std::is_same_v<T, MarketStatus>) {
+    return RecordType::MARKET_STATUS;
+  } else if constexpr (std::is_same_v<T, TopOfBook>) {
+    return RecordType::TOP_OF_BOOK;
+  } else if constexpr (std::is_same_v<T, MarketByPriceUpdate>) {
+    return RecordType::MARKET_BY_PRICE_UPDATE;
+  } else if constexpr (std::is_same_v<T, MarketByOrderUpdate>) {
+    return RecordType::MARKET_BY_ORDER_UPDATE;
+  } else if constexpr (std::is_same_v<T, TradeSummary>) {
+    return RecordType::TRADE_SUMMARY;
+  } else {
+    static_assert(utils::always_false<T>, "not supported for this type");
+  }
+}
+
+template <typename T, typename U>
+concept Is = std::is_same_v<std::remove_const_t<T>, U>;
+
+// note! types containing views can't use the native layout
+template <typename T>
+constexpr bool const HAS_VIEWS = std::is_same_v<T, Trade> || std::is_same_v<T, MBOUpdate>;
+
+// === FIELDS ===
+
+// note! used for both encoding and decoding (the order is the format)
+
+template <typename Archive, Is<MBOUpdate> T>
+void visit(Archive &archive, T &value) {
+  archive(value.price, value.quantity, value.priority, value.order_id, value.side, value.action, value.reason);
+}
+
+template <typename Archive, Is<Trade> T>
+void visit(Archive &archive, T &value) {
+  archive(value.side, value.price, value.quantity, value.trade_id);
+}
+
+template <typename Archive, Is<ReferenceData> T>
+void visit(Archive &archive, T &value) {
+  archive(
+      value.stream_id,
+      value.exchange,
+      value.symbol,
+      value.description,
+      value.security_type,
+      value.external_security_id,
+      value.cfi_code,
+      value.base_currency,
+      value.quote_currency,
+      value.settlement_currency,
+      value.margin_currency,
+      value.commission_currency,
+      value.tick_size,
+      value.tick_size_steps,
+      value.multiplier,
+      value.min_notional,
+      value.min_trade_vol,
+      value.max_trade_vol,
+      value.trade_vol_step_size,
+      value.option_type,
+      value.strike_currency,
+      value.strike_price,
+      value.underlying,
+      value.time_zone,
+      value.issue_date,
+      value.settlement_date,
+      value.expiry_datetime,
+      value.expiry_datetime_utc,
+      value.exchange_time_utc,
+      value.exchange_sequence,
+      value.sending_time_utc,
+      value.discard);
+}
+
+template <typename Archive, Is<MarketStatus> T>
+void visit(Archive &archive, T &value) {
+  archive(value.stream_id, value.exchange, value.symbol, value.trading_status, value.exchange_time_utc, value.exchange_sequence, value.sending_time_utc);
+}
+
+template <typename Archive, Is<TopOfBook> T>
+void visit(Archive &archive, T &value) {
+  archive(
+      value.stream_id,
+      value.exchange,
+      value.symbol,
+      value.layer,
+      value.update_type,
+      value.exchange_time_utc,
+      value.exchange_sequence,
+      value.sending_time_utc);
+}
+
+template <typename Archive, Is<MarketByPriceUpdate> T>
+void visit(Archive &archive, T &value) {
+  archive(
+      value.stream_id,
+      value.exchange,
+      value.symbol,
+      value.bids,
+      value.asks,
+      value.update_type,
+      value.exchange_time_utc,
+      value.exchange_sequence,
+      value.sending_time_utc,
+      value.price_precision,
+      value.quantity_precision,
+      value.max_depth,
+      value.checksum);
+}
+
+template <typename Archive, Is<MarketByOrderUpdate> T>
+void visit(Archive &archive, T &value) {
+  archive(
+      value.stream_id,
+      value.exchange,
+      value.symbol,
+      value.orders,
+      value.update_type,
+      value.exchange_time_utc,
+      value.exchange_sequence,
+      value.sending_time_utc,
+      value.price_precision,
+      value.quantity_precision,
+      value.max_depth,
+      value.checksum);
+}
+
+template <typename Archive, Is<TradeSummary> T>
+void visit(Archive &archive, T &value) {
+  archive(value.stream_id, value.exchange, value.symbol, value.trades, value.exchange_time_utc, value.exchange_sequence, value.sending_time_utc);
+}
+
+// === ENCODER ===
+
+struct Encoder final {
+  explicit Encoder(std::vector<std::byte> &buffer) : buffer_{buffer} {}
+
+  template <typename... Args>
+  void operator()(Args const &...args) {
+    (put(args), ...);
+  }
+
+  void align() { buffer_.resize((std::size(buffer_) + ALIGNMENT - 1) & ~(ALIGNMENT - 1)); }
+
+ protected:
+  void append(void const *data, size_t length) {
+    auto begin = static_cast<std::byte const *>(data);
+    buffer_.insert(std::end(buffer_), begin, begin + length);
+  }
+
+  void put(std::string_view const &value) {
+    put(static_cast<uint32_t>(std::size(value)));
+    append(std::data(value), std::size(value));
+  }
+
+  template <typename T>
+  void put(std::span<T const> const &value) {
+    put(static_cast<uint32_t>(std::size(value)));
+    if constexpr (HAS_VIEWS<T>) {
+      for (auto &item : value) {
+        visit(*this, item);
+      }
+    } else {
+      static_assert(std::is_trivially_copyable_v<T>);
+      align();
+      append(std::data(value), std::size(value) * sizeof(T));
+    }
+  }
+
+  template <typename T>
+  void put(T const &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    append(&value, sizeof(T));
+  }
+
+ private:
+  std::vector<std::byte> &buffer_;
+};
+
+// === DECODER ===
+
+// note! re-used between messages (no allocation once the capacity is sufficient)
+struct Buffers final {
+  std::vector<Trade> trades;
+  std::vector<MBOUpdate> orders;
+};
+
+struct Decoder final {
+  Decoder(std::span<std::byte const> const &payload, Buffers &buffers) : payload_{payload}, buffers_{buffers} {}
+
+  template <typename... Args>
+  void operator()(Args &...args) {
+    (get(args), ...);
+  }
+
+ protected:
+  std::byte const *consume(size_t length) {
+    using namespace std::literals;
+    if ((offset_ + length) > std::size(payload_)) [[unlikely]] {
+      throw RuntimeError{"Unexpected: corrupt record"sv};
+    }
+    auto result = std::data(payload_) + offset_;
+    offset_ += length;
+    return result;
+  }
+
+  void align() { offset_ = (offset_ + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+  void get(std::string_view &value) {
+    uint32_t length;
+    get(length);
+    value = {reinterpret_cast<char const *>(consume(length)), length};
+  }
+
+  template <typename T>
+  void get(std::span<T const> &value) {
+    uint32_t length;
+    get(length);
+    if constexpr (HAS_VIEWS<T>) {
+      auto &buffer = get_buffer<T>();
+      buffer.resize(length);
+      for (auto &item : buffer) {
+        visit(*this, item);
+      }
+      value = buffer;
+    } else {
+      align();
+      auto data = consume(length * sizeof(T));
+      assert(reinterpret_cast<uintptr_t>(data) % alignof(T) == 0);
+      // note! zero-copy (the native layout was recorded)
+      value = {reinterpret_cast<T const *>(data), length};
+    }
+  }
+
+  template <typename T>
+  void get(T &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+  }
+
+  template <typename T>
+  std::vector<T> &get_buffer() {
+    if constexpr (std::is_same_v<T, Trade>) {
+      return buffers_.trades;
+    } else if constexpr (std::is_same_v<T, MBOUpdate>) {
+      return buffers_.orders;
+    } else {
+      static_assert(utils::always_false<T>, "not supported for this type");
+    }
+  }
+
+ private:
+  std::span<std::byte const> const payload_;
+  Buffers &buffers_;
+  size_t offset_ = {};
+};
+
+}  // namespace event_log
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,162 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/simulator/event_log_reader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/algo/simulator/event_log.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// === HELPERS ===
+
+namespace {
+auto map_file(std::string_view const &path) {
+  auto fd = ::open(std::string{path}.c_str(), O_RDONLY);
+  if (fd < 0) [[unlikely]] {
+    throw RuntimeError{R"(Failed to open file (path="{}", errno={}))"sv, path, errno};
+  }
+  struct stat sb;
+  if (::fstat(fd, &sb) < 0) [[unlikely]] {
+    auto error = errno;
+    ::close(fd);
+    throw RuntimeError{R"(Failed to stat file (path="{}", errno={}))"sv, path, error};
+  }
+  auto length = static_cast<size_t>(sb.st_size);
+  if (length < sizeof(event_log::FileHeader)) [[unlikely]] {
+    ::close(fd);
+    throw RuntimeError{R"(Unexpected: file too small (path="{}"))"sv, path};
+  }
+  auto address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // note! the mapping remains valid
+  if (address == MAP_FAILED) [[unlikely]] {
+    throw RuntimeError{R"(Failed to map file (path="{}", errno={}))"sv, path, errno};
+  }
+  // note! aggressive read-ahead
+  if (::madvise(address, length, MADV_SEQUENTIAL) < 0) [[unlikely]] {
+    log::warn("Failed to advise sequential access (errno={})"sv, errno);
+  }
+  return std::span<std::byte const>{static_cast<std::byte const *>(address), length};
+}
+
+template <typename T, typename Handler>
+void dispatch(Handler &handler, MessageInfo const &message_info, std::span<std::byte const> const &payload, event_log::Buffers &buffers) {
+  T value;
+  event_log::Decoder decoder{payload, buffers};
+  event_log::visit(decoder, value);
+  Event event{message_info, value};
+  handler(event);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+EventLogReader::EventLogReader(std::string_view const &path) : data_{map_file(path)} {
+  event_log::FileHeader header;
+  std::memcpy(&header, std::data(data_), sizeof(header));
+  if (header.magic != event_log::MAGIC || header.version != event_log::VERSION) [[unlikely]] {
+    ::munmap(const_cast<std::byte *>(std::data(data_)), std::size(data_));
+    throw RuntimeError{R"(Unexpected: not an event log (path="{}", version={}))"sv, path, header.version};
+  }
+  log::info(R"(Mapped event log (path="{}", size={}))"sv, path, std::size(data_));
+}
+
+EventLogReader::~EventLogReader() {
+  ::munmap(const_cast<std::byte *>(std::data(data_)), std::size(data_));
+}
+
+void EventLogReader::operator()(Sweep::Handler &handler) const {
+  replay(handler);
+}
+
+void EventLogReader::operator()(Matcher &matcher) const {
+  replay(matcher);
+}
+
+void EventLogReader::operator()(Strategy &strategy) const {
+  replay(strategy);
+}
+
+template <typename Handler>
+void EventLogReader::replay(Handler &handler) const {
+  // note! views into the mapped memory
+  std::array<std::string_view, 256> source_names;
+  event_log::Buffers buffers;
+  auto offset = sizeof(event_log::FileHeader);
+  while (offset < std::size(data_)) {
+    event_log::RecordHeader header;
+    if ((offset + sizeof(header)) > std::size(data_)) [[unlikely]] {
+      throw RuntimeError{"Unexpected: truncated record (offset={})"sv, offset};
+    }
+    std::memcpy(&header, std::data(data_) + offset, sizeof(header));
+    if (header.length < sizeof(header) || (offset + header.length) > std::size(data_)) [[unlikely]] {
+      throw RuntimeError{"Unexpected: truncated record (offset={})"sv, offset};
+    }
+    auto payload = data_.subspan(offset + sizeof(header), header.length - sizeof(header));
+    offset += header.length;
+    auto receive_time = std::chrono::nanoseconds{header.receive_time};
+    auto message_info = MessageInfo{
+        .source = header.source,
+        .source_name = source_names[header.source],
+        .source_session_id = {},
+        .source_seqno = header.source_seqno,
+        .receive_time_utc = std::chrono::nanoseconds{header.receive_time_utc},
+        .receive_time = receive_time,
+        .source_send_time = receive_time,
+        .source_receive_time = receive_time,
+        .origin_create_time = receive_time,
+        .origin_create_time_utc = std::chrono::nanoseconds{header.receive_time_utc},
+        .is_last = true,
+        .opaque = {},
+    };
+    switch (header.type) {
+      using enum event_log::RecordType;
+      case UNDEFINED:
+        throw RuntimeError{"Unexpected: record type (offset={})"sv, offset};
+      case SOURCE:
+        event_log::Decoder{payload, buffers}(source_names[header.source]);
+        break;
+      case REFERENCE_DATA:
+        dispatch<ReferenceData>(handler, message_info, payload, buffers);
+        break;
+      case MARKET_STATUS:
+        dispatch<MarketStatus>(handler, message_info, payload, buffers);
+        break;
+      case TOP_OF_BOOK:
+        dispatch<TopOfBook>(handler, message_info, payload, buffers);
+        break;
+      case MARKET_BY_PRICE_UPDATE:
+        dispatch<MarketByPriceUpdate>(handler, message_info, payload, buffers);
+        break;
+      case MARKET_BY_ORDER_UPDATE:
+        dispatch<MarketByOrderUpdate>(handler, message_info, payload, buffers);
+        break;
+      case TRADE_SUMMARY:
+        dispatch<TradeSummary>(handler, message_info, payload, buffers);
+        break;
+      default:
+        // note! forward compatible
+        log::warn("Unknown record type (type={}, offset={})"sv, static_cast<uint8_t>(header.type), offset);
+    }
+  }
+}
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,126 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/simulator/event_log_writer.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/algo/simulator/event_log.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// === HELPERS ===
+
+namespace {
+void encode_header(auto &buffer, event_log::RecordType type, MessageInfo const &message_info) {
+  auto header = event_log::RecordHeader{
+      .length = {},  // note! updated when the record is complete
+      .type = type,
+      .source = message_info.source,
+      .reserved = {},
+      .source_seqno = message_info.source_seqno,
+      .receive_time = message_info.receive_time.count(),
+      .receive_time_utc = message_info.receive_time_utc.count(),
+  };
+  auto begin = reinterpret_cast<std::byte const *>(&header);
+  buffer.assign(begin, begin + sizeof(header));
+}
+
+void encode_length(auto &buffer) {
+  event_log::Encoder{buffer}.align();
+  auto length = static_cast<uint32_t>(std::size(buffer));
+  std::memcpy(std::data(buffer), &length, sizeof(length));
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+EventLogWriter::EventLogWriter(std::string_view const &path) {
+  log::info(R"(Create event log (path="{}"))"sv, path);
+  file_ = std::fopen(std::string{path}.c_str(), "wb");
+  if (file_ == nullptr) [[unlikely]] {
+    throw RuntimeError{R"(Failed to open file (path="{}", errno={}))"sv, path, errno};
+  }
+  auto header = event_log::FileHeader{
+      .magic = event_log::MAGIC,
+      .version = event_log::VERSION,
+      .reserved = {},
+  };
+  auto begin = reinterpret_cast<std::byte const *>(&header);
+  buffer_.assign(begin, begin + sizeof(header));
+  write_buffer();
+}
+
+EventLogWriter::~EventLogWriter() {
+  if (file_ != nullptr) {
+    std::fclose(file_);
+  }
+}
+
+void EventLogWriter::flush() {
+  std::fflush(file_);
+}
+
+void EventLogWriter::operator()(Event<ReferenceData> const &event) {
+  write(event);
+}
+
+void EventLogWriter::operator()(Event<MarketStatus> const &event) {
+  write(event);
+}
+
+void EventLogWriter::operator()(Event<TopOfBook> const &event) {
+  write(event);
+}
+
+void EventLogWriter::operator()(Event<MarketByPriceUpdate> const &event) {
+  write(event);
+}
+
+void EventLogWriter::operator()(Event<MarketByOrderUpdate> const &event) {
+  write(event);
+}
+
+void EventLogWriter::operator()(Event<TradeSummary> const &event) {
+  write(event);
+}
+
+template <typename T>
+void EventLogWriter::write(Event<T> const &event) {
+  auto &[message_info, value] = event;
+  if (!sources_[message_info.source]) [[unlikely]] {
+    write_source(message_info);
+    sources_[message_info.source] = true;
+  }
+  encode_header(buffer_, event_log::get_record_type<T>(), message_info);
+  event_log::Encoder encoder{buffer_};
+  event_log::visit(encoder, value);
+  encode_length(buffer_);
+  write_buffer();
+}
+
+void EventLogWriter::write_source(MessageInfo const &message_info) {
+  encode_header(buffer_, event_log::RecordType::SOURCE, message_info);
+  event_log::Encoder{buffer_}(message_info.source_name);
+  encode_length(buffer_);
+  write_buffer();
+}
+
+void EventLogWriter::write_buffer() {
+  if (std::fwrite(std::data(buffer_), 1, std::size(buffer_), file_) != std::size(buffer_)) [[unlikely]] {
+    throw RuntimeError{"Failed to write (errno={})"sv, errno};
+  }
+}
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
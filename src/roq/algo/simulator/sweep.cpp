@@ -0,0 +1,625 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/simulator/sweep.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <list>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include "roq/logging.hpp"
+
+#include "roq/utils/common.hpp"
+#include "roq/utils/container.hpp"
+
+#include "roq/algo/matcher/group.hpp"
+#include "roq/algo/matcher/quotes.hpp"
+
+#include "roq/algo/simulator/timing_wheel.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace simulator {
+
+// === HELPERS ===
+
+namespace {
+// note! one simulation (strategy => matcher group => strategy) with all output also dispatched to the reporter
+// note! requests are in-flight (deep copy) until the order management latency has expired
+//   this is also required with zero latency because the matchers are not re-entrant (a strategy may send requests from within a callback)
+struct Pipeline final : public Sweep::Handler, public Strategy::Dispatcher, public OrderCache {
+  Pipeline(Sweep::Config const &config, size_t index, Sweep::CreateStrategy const &create_strategy, Reporter &reporter)
+      : order_management_latency_{config.order_management_latency}, random_{index}, reporter_{reporter}, output_{*this},
+        group_{config.matcher_type, output_, *this, config.market_data_source}, strategy_{create_strategy(index, *this, *this)} {
+    if (!strategy_) [[unlikely]] {
+      log::fatal("Unexpected: strategy (index={})"sv, index);
+    }
+  }
+
+  Pipeline(Pipeline const &) = delete;
+
+  // note! end of the event stream => requests still in-flight are processed (anything sent after the last expiry is dropped)
+  void finish() {
+    process_requests(max_expiry_);
+    if (!in_flight_.empty()) [[unlikely]] {
+      log::warn("Dropped {} in-flight request(s) at the end of the event stream"sv, std::size(in_flight_));
+    }
+  }
+
+  // note! owns the storage referenced by the request (never moved)
+  struct Request final {
+    explicit Request(uint8_t source) : source{source} {}
+
+    Request(Request const &) = delete;
+
+    std::string_view store(std::string_view const &value) {
+      if (std::empty(value)) {
+        return {};
+      }
+      return strings.emplace_back(value);
+    }
+
+    std::span<MBPUpdate const> store(std::span<MBPUpdate const> const &value) {
+      if (std::empty(value)) {
+        return {};
+      }
+      return levels.emplace_back(std::begin(value), std::end(value));
+    }
+
+    uint8_t const source;
+    std::variant<CreateOrder, ModifyOrder, CancelOrder, CancelAllOrders, MassQuote, CancelQuotes> value;
+    // note! list => stable references
+    std::list<std::string> strings;
+    std::list<std::vector<MBPUpdate>> levels;
+    std::vector<Quote> quotes;
+  };
+
+ protected:
+  // Sweep::Handler
+
+  void operator()(Event<Timer> const &event) override { dispatch(event); }
+
+  void operator()(Event<Connected> const &event) override { dispatch(event); }
+  void operator()(Event<Disconnected> const &event) override { dispatch(event); }
+
+  void operator()(Event<DownloadBegin> const &event) override { dispatch(event); }
+  void operator()(Event<DownloadEnd> const &event) override { dispatch(event); }
+  void operator()(Event<Ready> const &event) override { dispatch(event); }
+
+  void operator()(Event<GatewaySettings> const &event) override { dispatch(event); }
+
+  void operator()(Event<StreamStatus> const &event) override { dispatch(event); }
+  void operator()(Event<ExternalLatency> const &event) override { dispatch(event); }
+  void operator()(Event<RateLimitTrigger> const &event) override { dispatch(event); }
+
+  void operator()(Event<GatewayStatus> const &event) override { dispatch(event); }
+
+  // note! the matcher will dispatch market data to the strategy (and the reporter)
+  void operator()(Event<ReferenceData> const &event) override { dispatch_to_matcher(event); }
+  void operator()(Event<MarketStatus> const &event) override { dispatch_to_matcher(event); }
+  void operator()(Event<TopOfBook> const &event) override { dispatch_to_matcher(event); }
+  void operator()(Event<MarketByPriceUpdate> const &event) override { dispatch_to_matcher(event); }
+  void operator()(Event<MarketByOrderUpdate> const &event) override { dispatch_to_matcher(event); }
+  void operator()(Event<TradeSummary> const &event) override { dispatch_to_matcher(event); }
+  void operator()(Event<StatisticsUpdate> const &event) override { dispatch_to_matcher(event); }
+
+  void operator()(Event<PositionUpdate> const &event) override { dispatch(event); }
+  void operator()(Event<FundsUpdate> const &event) override { dispatch(event); }
+
+  // Strategy::Dispatcher
+
+  void operator()(ControlAck const &, uint8_t) override {}
+  void operator()(ServiceUpdate const &) override {}
+  void operator()(StrategyUpdate const &) override {}
+  void operator()(LegsUpdate const &) override {}
+
+  void send(CreateOrder const &create_order, uint8_t source, bool) override {
+    auto request = std::make_unique<Request>(source);
+    auto tmp = create_order;
+    tmp.account = (*request).store(create_order.account);
+    tmp.exchange = (*request).store(create_order.exchange);
+    tmp.symbol = (*request).store(create_order.symbol);
+    tmp.request_template = (*request).store(create_order.request_template);
+    tmp.routing_id = (*request).store(create_order.routing_id);
+    (*request).value = tmp;
+    schedule(std::move(request));
+  }
+
+  void send(ModifyOrder const &modify_order, uint8_t source, bool) override {
+    auto request = std::make_unique<Request>(source);
+    auto tmp = modify_order;
+    tmp.account = (*request).store(modify_order.account);
+    tmp.request_template = (*request).store(modify_order.request_template);
+    tmp.routing_id = (*request).store(modify_order.routing_id);
+    (*request).value = tmp;
+    schedule(std::move(request));
+  }
+
+  void send(CancelOrder const &cancel_order, uint8_t source, bool) override {
+    auto request = std::make_unique<Request>(source);
+    auto tmp = cancel_order;
+    tmp.account = (*request).store(cancel_order.account);
+    tmp.request_template = (*request).store(cancel_order.request_template);
+    tmp.routing_id = (*request).store(cancel_order.routing_id);
+    (*request).value = tmp;
+    schedule(std::move(request));
+  }
+
+  void send(CancelAllOrders const &cancel_all_orders, uint8_t source) override {
+    auto request = std::make_unique<Request>(source);
+    auto tmp = cancel_all_orders;
+    tmp.account = (*request).store(cancel_all_orders.account);
+    tmp.exchange = (*request).store(cancel_all_orders.exchange);
+    tmp.symbol = (*request).store(cancel_all_orders.symbol);
+    (*request).value = tmp;
+    schedule(std::move(request));
+  }
+
+  void send(MassQuote const &mass_quote, uint8_t source) override {
+    auto request = std::make_unique<Request>(source);
+    auto &quotes = (*request).quotes;
+    for (auto &quote : mass_quote.quotes) {
+      auto tmp = quote;
+      tmp.exchange = (*request).store(quote.exchange);
+      tmp.symbol = (*request).store(quote.symbol);
+      tmp.bids = (*request).store(quote.bids);
+      tmp.asks = (*request).store(quote.asks);
+      quotes.emplace_back(tmp);
+    }
+    auto tmp = mass_quote;
+    tmp.account = (*request).store(mass_quote.account);
+    tmp.quotes = quotes;
+    (*request).value = tmp;
+    schedule(std::move(request));
+  }
+
+  void send(CancelQuotes const &cancel_quotes, uint8_t source) override {
+    auto request = std::make_unique<Request>(source);
+    auto tmp = cancel_quotes;
+    tmp.account = (*request).store(cancel_quotes.account);
+    tmp.exchange = (*request).store(cancel_quotes.exchange);
+    tmp.symbol = (*request).store(cancel_quotes.symbol);
+    (*request).value = tmp;
+    schedule(std::move(request));
+  }
+
+  // note! not simulated
+  void send(CustomMetrics const &, uint8_t) override {}
+  void send(CustomMatrix const &, uint8_t) override {}
+
+  // OrderCache
+
+  uint64_t get_next_trade_id() override { return ++next_trade_id_; }
+
+  cache::Order *get_order_helper(uint64_t order_id) override {
+    auto iter = orders_.find(order_id);
+    if (iter == std::end(orders_)) {
+      return nullptr;
+    }
+    return &(*iter).second;
+  }
+
+  // matcher => strategy (and reporter)
+
+  struct Output final : public Matcher::Dispatcher {
+    explicit Output(Pipeline &pipeline) : pipeline_{pipeline} {}
+
+   protected:
+    void operator()(Event<ReferenceData> const &event) override { pipeline_.dispatch_from_matcher(event); }
+    void operator()(Event<MarketStatus> const &event) override { pipeline_.dispatch_from_matcher(event); }
+
+    void operator()(Event<TopOfBook> const &event) override { pipeline_.dispatch_from_matcher(event); }
+    void operator()(Event<MarketByPriceUpdate> const &event) override { pipeline_.dispatch_from_matcher(event); }
+    void operator()(Event<MarketByOrderUpdate> const &event) override { pipeline_.dispatch_from_matcher(event); }
+    void operator()(Event<TradeSummary> const &event) override { pipeline_.dispatch_from_matcher(event); }
+    void operator()(Event<StatisticsUpdate> const &event) override { pipeline_.dispatch_from_matcher(event); }
+
+    void operator()(Event<OrderAck> const &event) override { pipeline_.dispatch_from_matcher(event, event.value.order_id); }
+    void operator()(Event<OrderUpdate> const &event) override { pipeline_.dispatch_from_matcher(event, event.value.order_id); }
+    void operator()(Event<TradeUpdate> const &event) override { pipeline_.dispatch_from_matcher(event, event.value.order_id); }
+
+    void operator()(Event<CancelAllOrdersAck> const &event) override { pipeline_.dispatch_from_matcher(event); }
+
+    void operator()(Event<MassQuoteAck> const &event) override { pipeline_.dispatch_from_matcher(event); }
+    void operator()(Event<CancelQuotesAck> const &event) override { pipeline_.dispatch_from_matcher(event); }
+
+   private:
+    Pipeline &pipeline_;
+  };
+
+  template <typename T>
+  void dispatch(Event<T> const &event) {
+    process_requests(event.message_info.receive_time);
+    update(event.message_info);
+    reporter_(event);
+    (*strategy_)(event);
+    process_requests(receive_time_);
+  }
+
+  template <typename T>
+  void dispatch_to_matcher(Event<T> const &event) {
+    process_requests(event.message_info.receive_time);
+    update(event.message_info);
+    group_(event);
+    process_requests(receive_time_);
+  }
+
+  template <typename T>
+  void dispatch_from_matcher(Event<T> const &event) {
+    reporter_(event);
+    (*strategy_)(event);
+  }
+
+  // note! quotes are not managed by the order cache => the order is derived from the update (transient)
+  template <typename T>
+  void dispatch_from_matcher(Event<T> const &event, uint64_t order_id) {
+    reporter_(event);
+    if (matcher::Quotes::is_quote(order_id)) {
+      auto &value = event.value;
+      transient_ = {};
+      transient_.account = value.account;
+      transient_.order_id = value.order_id;
+      transient_.exchange = value.exchange;
+      transient_.symbol = value.symbol;
+      transient_.side = value.side;
+      if constexpr (std::is_same_v<T, OrderUpdate>) {
+        transient_.quantity = value.quantity;
+        transient_.price = value.price;
+        transient_.order_status = value.order_status;
+        transient_.remaining_quantity = value.remaining_quantity;
+        transient_.traded_quantity = value.traded_quantity;
+        transient_.average_traded_price = value.average_traded_price;
+        transient_.create_time_utc = value.create_time_utc;
+        transient_.update_time_utc = value.update_time_utc;
+        transient_.strategy_id = value.strategy_id;
+      }
+      (*strategy_)(event, transient_);
+      return;
+    }
+    auto order = get_order_helper(order_id);
+    if (order == nullptr) [[unlikely]] {
+      log::fatal("Unexpected: order_id={}"sv, order_id);
+    }
+    (*strategy_)(event, *order);
+  }
+
+  void update(MessageInfo const &message_info) {
+    receive_time_ = message_info.receive_time;
+    receive_time_utc_ = message_info.receive_time_utc;
+    utc_offset_ = receive_time_utc_ - receive_time_;
+    if (message_info.source >= std::size(source_names_)) [[unlikely]] {
+      source_names_.resize(message_info.source + 1);
+    }
+    auto &source_name = source_names_[message_info.source];
+    if (std::empty(source_name)) [[unlikely]] {
+      source_name = message_info.source_name;
+    }
+  }
+
+  void schedule(std::unique_ptr<Request> &&request) {
+    auto source = (*request).source;
+    auto latency = source < std::size(order_management_latency_) ? order_management_latency_[source].sample(random_) : std::chrono::nanoseconds{};
+    auto expiry = receive_time_ + latency;
+    max_expiry_ = std::max(expiry, max_expiry_);
+    in_flight_.push(expiry, std::move(request));
+  }
+
+  // note! processing a request may cause more requests to become in-flight (possibly with zero latency)
+  void process_requests(std::chrono::nanoseconds now) {
+    in_flight_.advance(now, [&](auto expiry, auto &request) {
+      receive_time_ = expiry;
+      receive_time_utc_ = expiry + utc_offset_;
+      std::visit([&](auto &value) { process((*request).source, value); }, (*request).value);
+    });
+  }
+
+  void process(uint8_t source, CreateOrder const &create_order) {
+    auto [iter, res] = orders_.try_emplace(create_order.order_id, create_order);
+    if (!res) [[unlikely]] {
+      log::warn("Unexpected: order_id={} already exists"sv, create_order.order_id);
+      transient_ = cache::Order{create_order};  // note! the existing order must not be changed
+      dispatch_reject(source, create_order, Error::INVALID_ORDER_ID);
+      return;
+    }
+    dispatch_to_matcher(source, create_order, (*iter).second);
+  }
+
+  void process(uint8_t source, ModifyOrder const &modify_order) {
+    auto order = get_order_helper(modify_order.order_id);
+    if (order == nullptr) [[unlikely]] {
+      log::warn("Unexpected: order_id={} not found"sv, modify_order.order_id);
+      transient_ = {};
+      transient_.account = modify_order.account;
+      transient_.order_id = modify_order.order_id;
+      dispatch_reject(source, modify_order, Error::UNKNOWN_ORDER_ID);
+      return;
+    }
+    dispatch_to_matcher(source, modify_order, *order);
+  }
+
+  void process(uint8_t source, CancelOrder const &cancel_order) {
+    auto order = get_order_helper(cancel_order.order_id);
+    if (order == nullptr) [[unlikely]] {
+      log::warn("Unexpected: order_id={} not found"sv, cancel_order.order_id);
+      transient_ = {};
+      transient_.account = cancel_order.account;
+      transient_.order_id = cancel_order.order_id;
+      dispatch_reject(source, cancel_order, Error::UNKNOWN_ORDER_ID);
+      return;
+    }
+    dispatch_to_matcher(source, cancel_order, *order);
+  }
+
+  template <typename T>
+  void process(uint8_t source, T const &value) {
+    dispatch_to_matcher(source, value);
+  }
+
+  // note! the request never reaches the matcher => rejected by the simulated gateway (using the transient order)
+  template <typename T>
+  void dispatch_reject(uint8_t source, T const &value, Error error) {
+    auto message_info = create_message_info(source);
+    reporter_(Event{message_info, value});
+    auto &order = transient_;
+    auto order_ack = OrderAck{
+        .account = order.account,
+        .order_id = order.order_id,
+        .exchange = order.exchange,
+        .symbol = order.symbol,
+        .side = order.side,
+        .position_effect = order.position_effect,
+        .margin_mode = order.margin_mode,
+        .quantity_type = order.quantity_type,
+        .request_type = utils::get_request_type<T>(),
+        .origin = Origin::GATEWAY,
+        .request_status = RequestStatus::REJECTED,
+        .error = error,
+        .text = magic_enum::enum_name(error),
+        .request_id = {},
+        .external_account = {},
+        .external_order_id = {},
+        .client_order_id = {},
+        .quantity = order.quantity,
+        .price = order.price,
+        .stop_price = order.stop_price,
+        .leverage = order.leverage,
+        .routing_id = {},
+        .version = utils::get_version(value),
+        .risk_exposure = NaN,
+        .risk_exposure_change = NaN,
+        .traded_quantity = order.traded_quantity,
+        .round_trip_latency = {},
+        .user = {},
+    };
+    Event event{message_info, order_ack};
+    reporter_(event);
+    (*strategy_)(event, order);
+  }
+
+  template <typename T, typename... Args>
+  void dispatch_to_matcher(uint8_t source, T const &value, Args &&...args) {
+    Event event{create_message_info(source), value};
+    reporter_(event);
+    group_(event, std::forward<Args>(args)...);
+  }
+
+  MessageInfo create_message_info(uint8_t source) {
+    return {
+        .source = source,
+        .source_name = source < std::size(source_names_) ? source_names_[source] : std::string_view{},
+        .source_session_id = {},
+        .source_seqno = ++source_seqno_,
+        .receive_time_utc = receive_time_utc_,
+        .receive_time = receive_time_,
+        .source_send_time = receive_time_,
+        .source_receive_time = receive_time_,
+        .origin_create_time = receive_time_,
+        .origin_create_time_utc = receive_time_utc_,
+        .is_last = true,
+        .opaque = {},
+    };
+  }
+
+ private:
+  std::vector<Latency> const order_management_latency_;
+  std::mt19937_64 random_;
+
+  Reporter &reporter_;
+  Output output_;
+  matcher::Group group_;
+  std::unique_ptr<Strategy> const strategy_;
+  utils::unordered_map<uint64_t, cache::Order> orders_;
+  cache::Order transient_;  // note! quotes and rejected requests (not in the order cache)
+  uint64_t next_trade_id_ = {};
+  uint64_t source_seqno_ = {};
+  std::chrono::nanoseconds receive_time_ = {};
+  std::chrono::nanoseconds receive_time_utc_ = {};
+  std::chrono::nanoseconds utc_offset_ = {};
+  std::vector<std::string> source_names_;
+  TimingWheel<std::unique_ptr<Request>> in_flight_;
+  std::chrono::nanoseconds max_expiry_ = {};
+};
+
+// note! the event stream is replayed once per batch and each event is fanned out to all pipelines of the batch
+// note! a pipeline throwing an exception is excluded from the remaining replay (the error is re-thrown by run)
+struct Fanout final : public Sweep::Handler {
+  struct Item final {
+    size_t index = {};
+    Pipeline *pipeline = nullptr;
+  };
+
+  Fanout(std::span<Item> const &items, std::span<std::exception_ptr> const &errors) : items_{items}, errors_{errors} {}
+
+  Fanout(Fanout const &) = delete;
+
+ protected:
+  void operator()(Event<Timer> const &event) override { dispatch(event); }
+
+  void operator()(Event<Connected> const &event) override { dispatch(event); }
+  void operator()(Event<Disconnected> const &event) override { dispatch(event); }
+
+  void operator()(Event<DownloadBegin> const &event) override { dispatch(event); }
+  void operator()(Event<DownloadEnd> const &event) override { dispatch(event); }
+  void operator()(Event<Ready> const &event) override { dispatch(event); }
+
+  void operator()(Event<GatewaySettings> const &event) override { dispatch(event); }
+
+  void operator()(Event<StreamStatus> const &event) override { dispatch(event); }
+  void operator()(Event<ExternalLatency> const &event) override { dispatch(event); }
+  void operator()(Event<RateLimitTrigger> const &event) override { dispatch(event); }
+
+  void operator()(Event<GatewayStatus> const &event) override { dispatch(event); }
+
+  void operator()(Event<ReferenceData> const &event) override { dispatch(event); }
+  void operator()(Event<MarketStatus> const &event) override { dispatch(event); }
+  void operator()(Event<TopOfBook> const &event) override { dispatch(event); }
+  void operator()(Event<MarketByPriceUpdate> const &event) override { dispatch(event); }
+  void operator()(Event<MarketByOrderUpdate> const &event) override { dispatch(event); }
+  void operator()(Event<TradeSummary> const &event) override { dispatch(event); }
+  void operator()(Event<StatisticsUpdate> const &event) override { dispatch(event); }
+
+  void operator()(Event<PositionUpdate> const &event) override { dispatch(event); }
+  void operator()(Event<FundsUpdate> const &event) override { dispatch(event); }
+
+  template <typename T>
+  void dispatch(Event<T> const &event) {
+    for (auto &item : items_) {
+      if (item.pipeline == nullptr) [[unlikely]] {
+        continue;
+      }
+      try {
+        static_cast<Sweep::Handler &>(*item.pipeline)(event);
+      } catch (...) {
+        errors_[item.index] = std::current_exception();
+        item.pipeline = nullptr;
+      }
+    }
+  }
+
+ private:
+  std::span<Item> const items_;
+  std::span<std::exception_ptr> const errors_;
+};
+
+size_t get_threads(Sweep::Config const &config) {
+  auto result = config.threads;
+  if (result == 0) {
+    result = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  return std::min(result, config.size);
+}
+
+// note! one batch per worker (the event stream is replayed once per batch)
+size_t get_batch_size(Sweep::Config const &config, size_t threads) {
+  if (threads == 0) {
+    return 1;
+  }
+  return std::max<size_t>((config.size + threads - 1) / threads, 1);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Sweep::Sweep(Config const &config, CreateStrategy const &create_strategy, CreateReporter const &create_reporter)
+    : config_{config}, create_strategy_{create_strategy}, create_reporter_{create_reporter} {
+}
+
+Sweep::~Sweep() = default;
+
+void Sweep::run(Source const &source) {
+  reporters_.clear();
+  reporters_.resize(config_.size);
+  std::vector<std::exception_ptr> errors(config_.size);
+  auto threads = get_threads(config_);
+  auto batch_size = get_batch_size(config_, threads);
+  // note! dynamic scheduling => an idle worker will always pick up the next pending batch
+  std::atomic<size_t> next = {};
+  auto worker = [&]() {
+    std::vector<std::unique_ptr<Reporter>> reporters;
+    std::vector<std::unique_ptr<Pipeline>> pipelines;
+    std::vector<Fanout::Item> items;
+    for (;;) {
+      auto first = next.fetch_add(batch_size, std::memory_order_relaxed);
+      if (first >= config_.size) {
+        break;
+      }
+      auto last = std::min(first + batch_size, config_.size);
+      reporters.clear();
+      pipelines.clear();
+      items.clear();
+      for (auto index = first; index < last; ++index) {
+        try {
+          // note! created by the worker thread (memory locality)
+          auto reporter = create_reporter_(index);
+          if (!reporter) [[unlikely]] {
+            log::fatal("Unexpected: reporter (index={})"sv, index);
+          }
+          auto pipeline = std::make_unique<Pipeline>(config_, index, create_strategy_, *reporter);
+          items.push_back({.index = index, .pipeline = pipeline.get()});
+          reporters.emplace_back(std::move(reporter));
+          pipelines.emplace_back(std::move(pipeline));
+        } catch (...) {
+          errors[index] = std::current_exception();
+        }
+      }
+      Fanout fanout{items, errors};
+      try {
+        source(fanout);
+      } catch (...) {
+        for (auto &item : items) {
+          errors[item.index] = std::current_exception();
+          item.pipeline = nullptr;
+        }
+      }
+      for (size_t i = 0; i < std::size(items); ++i) {
+        auto &item = items[i];
+        if (item.pipeline == nullptr) {
+          continue;
+        }
+        try {
+          (*item.pipeline).finish();
+          reporters_[item.index] = std::move(reporters[i]);
+        } catch (...) {
+          errors[item.index] = std::current_exception();
+        }
+      }
+    }
+  };
+  log::info("Sweep (size={}, threads={}, batch_size={})"sv, config_.size, threads, batch_size);
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 0; i < threads; ++i) {
+      workers.emplace_back(worker);
+    }
+  }  // note! join
+  for (auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+Reporter const &Sweep::get_reporter(size_t index) const {
+  if (index >= std::size(reporters_) || !reporters_[index]) [[unlikely]] {
+    log::fatal("Unexpected: index={}"sv, index);
+  }
+  return *reporters_[index];
+}
+
+}  // namespace simulator
+}  // namespace algo
+}  // namespace roq
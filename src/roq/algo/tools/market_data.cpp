@@ -2,18 +2,8 @@
 
 #include "roq/algo/tools/market_data.hpp"
 
-#include <cassert>
-
 #include "roq/logging.hpp"
 
-#include "roq/utils/update.hpp"
-
-#include "roq/market/utils.hpp"
-
-#include "roq/market/mbp/factory.hpp"
-
-#include "roq/market/mbo/factory.hpp"
-
 using namespace std::literals;
 
 namespace roq {
@@ -23,126 +13,59 @@ namespace tools {
 // === HELPERS ===
 
 namespace {
-auto create_market_by_price(auto &exchange, auto &symbol) {
-  return market::mbp::Factory::create(exchange, symbol);
-}
-
-auto create_market_by_order(auto &exchange, auto &symbol) {
-  return market::mbo::Factory::create(exchange, symbol);
-}
-
-template <typename T>
-void update_exchange_time_utc(auto &result, Event<T> const &event) {
-  // note! we use max because market data could arrive out of sequence (different sources, streams, etc.)
-  utils::update_max(result, event.value.exchange_time_utc);
+template <typename R>
+R create_book(MarketDataSource market_data_source, auto &&...args) {
+  switch (market_data_source) {
+    using enum MarketDataSource;
+    case TOP_OF_BOOK:
+      return R{std::in_place_index<0>, args...};
+    case MARKET_BY_PRICE:
+      return R{std::in_place_index<1>, args...};
+    case MARKET_BY_ORDER:
+      return R{std::in_place_index<2>, args...};
+  }
+  throw RuntimeError{"Unexpected: market_data_source={}"sv, market_data_source};
 }
 }  // namespace
 
 // === IMPLEMENTATION ===
 
 MarketData::MarketData(std::string_view const &exchange, std::string_view const &symbol, MarketDataSource market_data_source)
-    : market_data_source_{market_data_source}, market_by_price_{create_market_by_price(exchange, symbol)},
-      market_by_order_{create_market_by_order(exchange, symbol)} {
+    : state_{market_data_source}, book_{create_book<decltype(book_)>(market_data_source, exchange, symbol)} {
 }
 
 MarketData::MarketData(Leg const &leg, MarketDataSource market_data_source)
-    : market_data_source_{market_data_source}, tick_size_{leg.tick_size}, multiplier_{leg.multiplier}, min_trade_vol_{leg.min_trade_vol},
-      market_by_price_{create_market_by_price(leg.exchange, leg.symbol)}, market_by_order_{create_market_by_order(leg.exchange, leg.symbol)} {
-}
-
-bool MarketData::is_market_active(MessageInfo const &message_info, std::chrono::nanoseconds max_age) const {
-  if (market_status_.trading_status != TradingStatus{}) {
-    return market_status_.trading_status == TradingStatus::OPEN;
-  }
-  // use age of market data update as fallback if exchange doesn't support trading status
-  return (message_info.receive_time_utc - exchange_time_utc_) < max_age;
-}
-
-std::pair<int64_t, bool> MarketData::price_to_ticks(double price) const {
-  assert(has_tick_size());
-  return market::price_to_ticks(price, tick_size_, precision_);
+    : state_{leg, market_data_source}, book_{create_book<decltype(book_)>(market_data_source, leg.exchange, leg.symbol)} {
 }
 
 double MarketData::total_quantity(Side side, double price) const {
-  switch (market_data_source_) {
-    using enum MarketDataSource;
-    case TOP_OF_BOOK:
-      break;
-    case MARKET_BY_PRICE:
-      return (*market_by_price_).total_quantity(side, price);
-    case MARKET_BY_ORDER:
-      return (*market_by_order_).total_quantity(side, price);
-  }
-  throw RuntimeError{"Unexpected: market_data_source={}"sv, market_data_source_};
+  return std::visit([&](auto &value) { return value.total_quantity(side, price); }, book_);
 }
 
 bool MarketData::operator()(Event<ReferenceData> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-  auto &[message_info, reference_data] = event;
-  top_of_book_(event);
-  (*market_by_price_)(event);
-  (*market_by_order_)(event);
-  auto result = false;
-  if (utils::update(tick_size_, event.value.tick_size)) {
-    result = true;
-    auto precision = market::increment_to_precision(tick_size_);
-    if (static_cast<std::underlying_type_t<decltype(precision)>>(precision) < static_cast<std::underlying_type_t<decltype(precision_)>>(precision_)) {
-      log::fatal("Unexpected"sv);  // note! we can't support loss of precision
-    }
-    // XXX FIXME internal prices must now be scaled relatively...
-    precision_ = precision;
-  }
-  result |= utils::update(multiplier_, reference_data.multiplier);
-  result |= utils::update(min_trade_vol_, reference_data.min_trade_vol);
-  return result;
-}
-
-bool MarketData::operator()(Event<MarketStatus> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-  return market_status_(event);
-}
-
-bool MarketData::operator()(Event<TopOfBook> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-  if (!top_of_book_(event)) {
-    return false;
-  }
-  if (market_data_source_ != MarketDataSource::TOP_OF_BOOK) {
-    return false;
-  }
-  best_ = top_of_book_.layer;
-  return true;
+  std::visit([&](auto &value) { value(event); }, book_);
+  return state_(event);
 }
 
 bool MarketData::operator()(Event<MarketByPriceUpdate> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-  (*market_by_price_)(event);
-  if (market_data_source_ != MarketDataSource::MARKET_BY_PRICE) {
-    return false;
-  }
-  (*market_by_price_).extract({&best_, 1}, true);
-  return true;
+  return update_best(event);
 }
 
 bool MarketData::operator()(Event<MarketByOrderUpdate> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-  (*market_by_order_)(event);
-  if (market_data_source_ != MarketDataSource::MARKET_BY_ORDER) {
+  return update_best(event);
+}
+
+template <typename T>
+bool MarketData::update_best(Event<T> const &event) {
+  state_(event);
+  auto best = state_.top_of_book();  // note! copy (the book could leave some fields unchanged)
+  if (!std::visit([&](auto &value) { return value(event, best); }, book_)) {
     return false;
   }
-  (*market_by_order_).extract_2({&best_, 1});
+  state_.set_best(best);
   return true;
 }
 
-bool MarketData::operator()(Event<TradeSummary> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-  return true;  // note! only incremental
-}
-
-void MarketData::operator()(Event<StatisticsUpdate> const &event) {
-  update_exchange_time_utc(exchange_time_utc_, event);
-}
-
 }  // namespace tools
 }  // namespace algo
 }  // namespace roq
@@ -0,0 +1,98 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/tools/market_data_book.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/market/mbp/factory.hpp"
+
+#include "roq/market/mbo/factory.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace tools {
+
+// === HELPERS ===
+
+namespace {
+template <MarketDataSource market_data_source>
+auto create_book(auto &exchange, auto &symbol) {
+  if constexpr (market_data_source == MarketDataSource::MARKET_BY_PRICE) {
+    return market::mbp::Factory::create(exchange, symbol);
+  } else if constexpr (market_data_source == MarketDataSource::MARKET_BY_ORDER) {
+    return market::mbo::Factory::create(exchange, symbol);
+  } else {
+    return std::monostate{};
+  }
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+template <MarketDataSource market_data_source>
+MarketDataBook<market_data_source>::MarketDataBook(std::string_view const &exchange, std::string_view const &symbol)
+    : exchange_{exchange}, symbol_{symbol} {
+}
+
+template <MarketDataSource market_data_source>
+auto &MarketDataBook<market_data_source>::get_book()
+  requires(market_data_source != MarketDataSource::TOP_OF_BOOK)
+{
+  if (!book_) [[unlikely]] {
+    book_ = create_book<market_data_source>(exchange_, symbol_);
+  }
+  return *book_;
+}
+
+template <MarketDataSource market_data_source>
+double MarketDataBook<market_data_source>::total_quantity(Side side, double price) const {
+  if constexpr (market_data_source == MarketDataSource::TOP_OF_BOOK) {
+    throw RuntimeError{"Unexpected: market_data_source={}"sv, market_data_source};
+  } else {
+    if (!book_) {
+      return 0.0;
+    }
+    return (*book_).total_quantity(side, price);
+  }
+}
+
+template <MarketDataSource market_data_source>
+void MarketDataBook<market_data_source>::operator()(Event<ReferenceData> const &event) {
+  if constexpr (market_data_source != MarketDataSource::TOP_OF_BOOK) {
+    get_book()(event);
+  }
+}
+
+template <MarketDataSource market_data_source>
+bool MarketDataBook<market_data_source>::operator()(Event<MarketByPriceUpdate> const &event, Layer &best) {
+  if constexpr (market_data_source != MarketDataSource::MARKET_BY_PRICE) {
+    return false;
+  } else {
+    get_book()(event);
+    get_book().extract({&best, 1}, true);
+    return true;
+  }
+}
+
+template <MarketDataSource market_data_source>
+bool MarketDataBook<market_data_source>::operator()(Event<MarketByOrderUpdate> const &event, Layer &best) {
+  if constexpr (market_data_source != MarketDataSource::MARKET_BY_ORDER) {
+    return false;
+  } else {
+    get_book()(event);
+    get_book().extract_2({&best, 1});
+    return true;
+  }
+}
+
+// === INSTANTIATIONS ===
+
+template struct MarketDataBook<MarketDataSource::TOP_OF_BOOK>;
+template struct MarketDataBook<MarketDataSource::MARKET_BY_PRICE>;
+template struct MarketDataBook<MarketDataSource::MARKET_BY_ORDER>;
+
+}  // namespace tools
+}  // namespace algo
+}  // namespace roq
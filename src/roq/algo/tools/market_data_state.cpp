@@ -0,0 +1,123 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/algo/tools/market_data_state.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "roq/logging.hpp"
+
+#include "roq/utils/compare.hpp"
+#include "roq/utils/update.hpp"
+
+#include "roq/market/utils.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace algo {
+namespace tools {
+
+// === HELPERS ===
+
+namespace {
+// note! internal prices can only be rescaled if the new tick size divides the old tick size
+// - otherwise zero is returned and internal prices must be re-derived from external prices
+int64_t compute_rescale_factor(double from, double to) {
+  using namespace std::literals;
+  auto result = std::round(from / to);
+  if (result < 1.0 || utils::compare(result * to, from) != 0) [[unlikely]] {
+    log::warn("Internal prices can not be rescaled (tick_size: from={}, to={}) => must be re-derived"sv, from, to);
+    return 0;
+  }
+  return static_cast<int64_t>(result);
+}
+
+template <typename T>
+void update_exchange_time_utc(auto &result, Event<T> const &event) {
+  // note! we use max because market data could arrive out of sequence (different sources, streams, etc.)
+  utils::update_max(result, event.value.exchange_time_utc);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+MarketDataState::MarketDataState(MarketDataSource market_data_source) : market_data_source_{market_data_source} {
+}
+
+MarketDataState::MarketDataState(Leg const &leg, MarketDataSource market_data_source)
+    : market_data_source_{market_data_source}, tick_size_{leg.tick_size}, multiplier_{leg.multiplier}, min_trade_vol_{leg.min_trade_vol} {
+}
+
+bool MarketDataState::is_market_active(MessageInfo const &message_info, std::chrono::nanoseconds max_age) const {
+  if (market_status_.trading_status != TradingStatus{}) {
+    return market_status_.trading_status == TradingStatus::OPEN;
+  }
+  // use age of market data update as fallback if exchange doesn't support trading status
+  return (message_info.receive_time_utc - exchange_time_utc_) < max_age;
+}
+
+std::pair<int64_t, bool> MarketDataState::price_to_ticks(double price) const {
+  assert(has_tick_size());
+  return market::price_to_ticks(price, tick_size_, precision_);
+}
+
+bool MarketDataState::operator()(Event<ReferenceData> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+  auto &[message_info, reference_data] = event;
+  top_of_book_(event);
+  auto result = false;
+  rescale_factor_ = 1;
+  auto has_tick_size = this->has_tick_size();
+  auto tick_size = tick_size_;
+  if (utils::update(tick_size_, event.value.tick_size)) {
+    result = true;
+    auto precision = market::increment_to_precision(tick_size_);
+    // note! internal prices only exist if a tick size was previously known
+    // - loss of precision (a coarser tick size) never divides the old tick size => internal prices must be re-derived
+    if (has_tick_size) {
+      rescale_factor_ = compute_rescale_factor(tick_size, tick_size_);
+    }
+    precision_ = precision;
+  }
+  result |= utils::update(multiplier_, reference_data.multiplier);
+  result |= utils::update(min_trade_vol_, reference_data.min_trade_vol);
+  return result;
+}
+
+bool MarketDataState::operator()(Event<MarketStatus> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+  return market_status_(event);
+}
+
+bool MarketDataState::operator()(Event<TopOfBook> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+  if (!top_of_book_(event)) {
+    return false;
+  }
+  if (market_data_source_ != MarketDataSource::TOP_OF_BOOK) {
+    return false;
+  }
+  best_ = top_of_book_.layer;
+  return true;
+}
+
+void MarketDataState::operator()(Event<MarketByPriceUpdate> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+}
+
+void MarketDataState::operator()(Event<MarketByOrderUpdate> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+}
+
+void MarketDataState::operator()(Event<TradeSummary> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+}
+
+void MarketDataState::operator()(Event<StatisticsUpdate> const &event) {
+  update_exchange_time_utc(exchange_time_utc_, event);
+}
+
+}  // namespace tools
+}  // namespace algo
+}  // namespace roq
@@ -0,0 +1,322 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "roq/algo/order_cache.hpp"
+
+#include "roq/algo/arbitrage/factory.hpp"
+#include "roq/algo/arbitrage/instrument_index.hpp"
+#include "roq/algo/arbitrage/instrument_state.hpp"
+#include "roq/algo/arbitrage/spread_engine.hpp"
+#include "roq/algo/arbitrage/spread_matrix.hpp"
+
+using namespace std::literals;
+
+using namespace Catch::literals;
+
+using namespace roq;
+
+// === CONSTANTS ===
+
+namespace {
+auto const ACCOUNT = "A1"sv;
+auto const EXCHANGES = std::array{"deribit"sv, "bybit"sv, "okx"sv};
+auto const SYMBOL = "BTC-PERPETUAL"sv;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+struct Dispatcher final : public algo::Strategy::Dispatcher {
+  void operator()(ControlAck const &, uint8_t) override {}
+  void operator()(ServiceUpdate const &) override {}
+  void operator()(StrategyUpdate const &) override {}
+  void operator()(LegsUpdate const &) override {}
+
+  void send(CreateOrder const &, uint8_t, bool) override { ++create_order; }
+  void send(ModifyOrder const &, uint8_t, bool) override {}
+  void send(CancelOrder const &, uint8_t, bool) override {}
+
+  void send(CancelAllOrders const &, uint8_t) override {}
+
+  void send(MassQuote const &, uint8_t) override {}
+  void send(CancelQuotes const &, uint8_t) override {}
+
+  void send(CustomMetrics const &custom_metrics, uint8_t) override { custom_metrics_.emplace_back(custom_metrics.exchange); }
+  void send(CustomMatrix const &, uint8_t) override { ++custom_matrix; }
+
+  // note! exchanges published since last call
+  std::vector<std::string> get_custom_metrics() { return std::move(custom_metrics_); }
+
+  size_t create_order = {};
+  size_t custom_matrix = {};
+
+ private:
+  std::vector<std::string> custom_metrics_;
+};
+
+struct OrderCache final : public algo::OrderCache {
+  cache::Order *get_order_helper(uint64_t) override { return nullptr; }
+  uint64_t get_next_trade_id() override { return {}; }
+};
+
+MessageInfo create_message_info(uint8_t source, std::chrono::nanoseconds receive_time) {
+  return {
+      .source = source,
+      .source_name = EXCHANGES[source],
+      .source_session_id = {},
+      .source_seqno = {},
+      .receive_time_utc = receive_time,
+      .receive_time = receive_time,
+      .source_send_time = {},
+      .source_receive_time = {},
+      .origin_create_time = {},
+      .origin_create_time_utc = {},
+      .is_last = true,
+      .opaque = {},
+  };
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("algo_arbitrage_spread_engine_1", "[algo_arbitrage]") {
+  auto spread_engine = algo::arbitrage::SpreadEngine{5};
+  auto const NOT_FOUND = algo::arbitrage::SpreadEngine::NOT_FOUND;
+  CHECK(spread_engine.find_max_bid(0) == NOT_FOUND);
+  CHECK(spread_engine.find_min_ask(0) == NOT_FOUND);
+  spread_engine.update(0, 100.0, 101.0);
+  CHECK(spread_engine.find_max_bid(0) == NOT_FOUND);  // note! excluded
+  CHECK(spread_engine.find_max_bid(1) == 0);
+  CHECK(spread_engine.find_min_ask(1) == 0);
+  spread_engine.update(1, 99.0, 100.5);
+  spread_engine.update(2, 102.0, 103.0);
+  spread_engine.update(4, 98.0, 99.5);
+  CHECK(spread_engine.find_max_bid(0) == 2);
+  CHECK(spread_engine.find_max_bid(2) == 0);  // note! next best
+  CHECK(spread_engine.find_min_ask(2) == 4);
+  CHECK(spread_engine.find_min_ask(4) == 1);
+  CHECK(spread_engine.get_bid_price(2) == 102.0_a);
+  CHECK(spread_engine.get_ask_price(4) == 99.5_a);
+  // note! ties => lower index
+  spread_engine.update(3, 102.0, 99.5);
+  CHECK(spread_engine.find_max_bid(0) == 2);
+  CHECK(spread_engine.find_min_ask(0) == 3);
+  CHECK(spread_engine.find_max_bid(2) == 3);
+  // note! unavailable
+  spread_engine.reset(2);
+  spread_engine.reset(3);
+  CHECK(spread_engine.find_max_bid(1) == 0);
+  CHECK(spread_engine.find_min_ask(1) == 4);
+  spread_engine.update(4, NaN, 99.0);
+  CHECK(spread_engine.find_max_bid(0) == 1);
+  CHECK(spread_engine.find_min_ask(0) == 4);
+}
+
+TEST_CASE("algo_arbitrage_instrument_index_1", "[algo_arbitrage]") {
+  auto create_leg = [](uint8_t source, std::string_view const &exchange, std::string_view const &symbol) {
+    auto result = algo::Leg{};
+    result.source = source;
+    result.exchange = exchange;
+    result.symbol = symbol;
+    return result;
+  };
+  auto legs = std::vector{
+      create_leg(2, "deribit"sv, "BTC-PERPETUAL"sv),
+      create_leg(0, "bybit"sv, "BTCUSDT"sv),
+      create_leg(2, "deribit"sv, "ETH-PERPETUAL"sv),
+      create_leg(0, "binance"sv, "BTCUSDT"sv),
+  };
+  std::vector<algo::arbitrage::Instrument> instruments;
+  for (auto &item : legs) {
+    instruments.emplace_back(item, algo::MarketDataSource::TOP_OF_BOOK);
+  }
+  auto instrument_index = algo::arbitrage::InstrumentIndex{instruments};
+  auto const NOT_FOUND = algo::arbitrage::InstrumentIndex::NOT_FOUND;
+  CHECK(std::size(instrument_index) == 4);
+  CHECK(instrument_index.find(2, "deribit"sv, "BTC-PERPETUAL"sv) == 0);
+  CHECK(instrument_index.find(0, "bybit"sv, "BTCUSDT"sv) == 1);
+  CHECK(instrument_index.find(2, "deribit"sv, "ETH-PERPETUAL"sv) == 2);
+  CHECK(instrument_index.find(0, "binance"sv, "BTCUSDT"sv) == 3);
+  CHECK(instrument_index.find(0, "deribit"sv, "BTC-PERPETUAL"sv) == NOT_FOUND);  // note! wrong source
+  CHECK(instrument_index.find(1, "bybit"sv, "BTCUSDT"sv) == NOT_FOUND);
+  CHECK(instrument_index.find(2, "deribit"sv, "SOL-PERPETUAL"sv) == NOT_FOUND);
+  CHECK(instrument_index.find(3, "deribit"sv, "BTC-PERPETUAL"sv) == NOT_FOUND);  // note! out of range
+  std::vector<size_t> result;
+  instrument_index.get_by_source(0, [&](auto index) { result.emplace_back(index); });
+  CHECK(result == std::vector<size_t>{3, 1});
+  result.clear();
+  instrument_index.get_by_source(1, [&](auto index) { result.emplace_back(index); });
+  CHECK(std::empty(result));
+}
+
+TEST_CASE("algo_arbitrage_spread_matrix_1", "[algo_arbitrage]") {
+  auto create_leg = [](std::string_view const &exchange, std::string_view const &symbol) {
+    auto result = algo::Leg{};
+    result.exchange = exchange;
+    result.symbol = symbol;
+    return result;
+  };
+  auto legs = std::vector{
+      create_leg("deribit"sv, "BTC-PERPETUAL"sv),
+      create_leg("bybit"sv, "BTCUSDT"sv),
+      create_leg("binance"sv, "BTCUSDT"sv),
+  };
+  std::vector<algo::arbitrage::Instrument> instruments;
+  for (auto &item : legs) {
+    instruments.emplace_back(item, algo::MarketDataSource::TOP_OF_BOOK);
+  }
+  auto spread_matrix = algo::arbitrage::SpreadMatrix{instruments};
+  REQUIRE(std::size(spread_matrix.get_headers()) == 3);
+  CHECK(std::string_view{spread_matrix.get_headers()[0]} == "deribit:BTC-PERPETUAL"sv);
+  CHECK(std::string_view{spread_matrix.get_headers()[2]} == "binance:BTCUSDT"sv);
+  REQUIRE(std::size(spread_matrix.get_data()) == 9);
+  spread_matrix.update(0, 100.0, 101.0);
+  CHECK(std::isnan(spread_matrix.get_spread(0, 0)));
+  CHECK(std::isnan(spread_matrix.get_spread(0, 1)));  // note! unavailable
+  spread_matrix.update(1, 99.0, 100.5);
+  spread_matrix.update(2, 102.0, 103.0);
+  CHECK(spread_matrix.get_spread(0, 1) == -0.5_a);
+  CHECK(spread_matrix.get_spread(1, 0) == -2.0_a);
+  CHECK(spread_matrix.get_spread(2, 0) == 1.0_a);
+  CHECK(spread_matrix.get_spread(2, 1) == 1.5_a);
+  CHECK(spread_matrix.get_spread(0, 2) == -3.0_a);
+  CHECK(std::isnan(spread_matrix.get_spread(2, 2)));
+  // note! only row and column of the updated instrument
+  auto data = std::data(spread_matrix.get_data());
+  spread_matrix.update(1, 104.0, 105.0);
+  CHECK(std::data(spread_matrix.get_data()) == data);
+  CHECK(spread_matrix.get_spread(1, 0) == 3.0_a);
+  CHECK(spread_matrix.get_spread(1, 2) == 1.0_a);
+  CHECK(spread_matrix.get_spread(0, 1) == -5.0_a);
+  CHECK(spread_matrix.get_spread(2, 1) == -3.0_a);
+  CHECK(spread_matrix.get_spread(2, 0) == 1.0_a);
+  spread_matrix.update(2, NaN, 103.0);
+  CHECK(std::isnan(spread_matrix.get_spread(2, 0)));
+  CHECK(spread_matrix.get_spread(0, 2) == -3.0_a);
+}
+
+TEST_CASE("algo_arbitrage_instrument_state_1", "[algo_arbitrage]") {
+  auto leg = algo::Leg{};
+  leg.exchange = "deribit"sv;
+  leg.symbol = "BTC-PERPETUAL"sv;
+  auto instrument = algo::arbitrage::Instrument{leg, algo::MarketDataSource::TOP_OF_BOOK};
+  auto instrument_state = algo::arbitrage::InstrumentState{2};
+  auto message_info = MessageInfo{};
+  message_info.source_name = "deribit"sv;
+  message_info.receive_time = 2s;
+  message_info.receive_time_utc = 2s;
+  CHECK(std::isnan(instrument_state.bid_prices[1]));
+  CHECK_FALSE(instrument_state.is_ready(1, message_info, 10s));
+  auto top_of_book = TopOfBook{};
+  top_of_book.exchange = "deribit"sv;
+  top_of_book.symbol = "BTC-PERPETUAL"sv;
+  top_of_book.layer = {
+      .bid_price = 100.0,
+      .bid_quantity = 1.0,
+      .ask_price = 101.0,
+      .ask_quantity = 2.0,
+  };
+  top_of_book.exchange_time_utc = 1s;
+  instrument(Event{message_info, top_of_book});
+  instrument_state.update(1, instrument);
+  CHECK(instrument_state.get_best(1) == std::pair{100.0, 101.0});
+  CHECK(instrument_state.ask_quantities[1] == 2.0_a);
+  CHECK(instrument_state.is_ready(1, message_info, 10s));
+  CHECK_FALSE(instrument_state.is_ready(1, message_info, 1s));  // note! stale
+  CHECK_FALSE(instrument_state.is_ready(0, message_info, 10s));
+  instrument_state.order_states[1] = algo::arbitrage::OrderState::WORKING;
+  CHECK_FALSE(instrument_state.is_ready(1, message_info, 10s));
+  instrument_state.reset(1);
+  CHECK(instrument_state.is_ready(1, message_info, 10s));
+}
+
+TEST_CASE("algo_arbitrage_simple_1", "[algo_arbitrage]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::strategy::Config{};
+  for (uint8_t source = 0; source < std::size(EXCHANGES); ++source) {
+    auto leg = algo::Leg{};
+    leg.source = source;
+    leg.account = ACCOUNT;
+    leg.exchange = EXCHANGES[source];
+    leg.symbol = SYMBOL;
+    config.legs.emplace_back(leg);
+  }
+  auto parameters = algo::arbitrage::Parameters{
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+      .max_age = 1h,
+      .threshold = 100.0,  // note! never exceeded (no orders)
+      .quantity_0 = 1.0,
+      .min_position_0 = -10.0,
+      .max_position_0 = 10.0,
+      .publish_source = 0,
+      .publish_interval = 10ms,
+  };
+  auto strategy = algo::arbitrage::Factory::create(dispatcher, order_cache, config, parameters);
+  std::chrono::nanoseconds now = 1s;
+  for (uint8_t source = 0; source < std::size(EXCHANGES); ++source) {
+    auto reference_data = ReferenceData{};
+    reference_data.exchange = EXCHANGES[source];
+    reference_data.symbol = SYMBOL;
+    reference_data.tick_size = 0.5;
+    reference_data.multiplier = 1.0;
+    reference_data.min_trade_vol = 1.0;
+    (*strategy)(Event{create_message_info(source, now), reference_data});
+  }
+  auto dispatch_top_of_book = [&](uint8_t source, std::chrono::nanoseconds receive_time, double bid_price) {
+    auto top_of_book = TopOfBook{};
+    top_of_book.exchange = EXCHANGES[source];
+    top_of_book.symbol = SYMBOL;
+    top_of_book.layer = {
+        .bid_price = bid_price,
+        .bid_quantity = 1.0,
+        .ask_price = bid_price + 1.0,
+        .ask_quantity = 1.0,
+    };
+    top_of_book.exchange_time_utc = receive_time;
+    (*strategy)(Event{create_message_info(source, receive_time), top_of_book});
+  };
+  auto dispatch_timer = [&](std::chrono::nanoseconds receive_time) {
+    auto timer = Timer{
+        .now = receive_time,
+    };
+    (*strategy)(Event{create_message_info(0, receive_time), timer});
+  };
+  // note! first update is published immediately
+  dispatch_top_of_book(0, now, 100.0);
+  CHECK(dispatcher.get_custom_metrics() == std::vector<std::string>{"deribit"});
+  CHECK(dispatcher.custom_matrix == 1);
+  // note! burst within the publish interval => conflated
+  for (size_t i = 0; i < 10; ++i) {
+    now += 100us;
+    dispatch_top_of_book(0, now, 100.0 + 0.5 * static_cast<double>(i % 2));
+    dispatch_top_of_book(1, now, 101.0 + 0.5 * static_cast<double>(i % 2));
+  }
+  CHECK(std::empty(dispatcher.get_custom_metrics()));
+  CHECK(dispatcher.custom_matrix == 1);
+  dispatch_timer(1s + 9ms);
+  CHECK(std::empty(dispatcher.get_custom_metrics()));
+  // note! timer driven flush => only dirty instruments (in the order they were updated)
+  dispatch_timer(1s + 10ms);
+  CHECK(dispatcher.get_custom_metrics() == std::vector<std::string>{"deribit", "bybit"});
+  CHECK(dispatcher.custom_matrix == 2);
+  // note! nothing dirty => nothing published
+  dispatch_timer(1s + 30ms);
+  CHECK(std::empty(dispatcher.get_custom_metrics()));
+  CHECK(dispatcher.custom_matrix == 2);
+  // note! the publish interval has elapsed => published immediately
+  dispatch_top_of_book(2, 1s + 31ms, 99.0);
+  CHECK(dispatcher.get_custom_metrics() == std::vector<std::string>{"okx"});
+  CHECK(dispatcher.custom_matrix == 3);
+  // note! ... and the next update is conflated again
+  dispatch_top_of_book(2, 1s + 32ms, 99.5);
+  CHECK(std::empty(dispatcher.get_custom_metrics()));
+  CHECK(dispatcher.create_order == 0);
+}
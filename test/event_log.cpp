@@ -0,0 +1,136 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <unistd.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "roq/algo/simulator/event_log_reader.hpp"
+#include "roq/algo/simulator/event_log_writer.hpp"
+
+using namespace std::literals;
+
+using namespace Catch::literals;
+
+using namespace roq;
+
+// === HELPERS ===
+
+namespace {
+struct Strategy final : public algo::Strategy {
+  void operator()(Event<ReferenceData> const &event) override {
+    source_name = event.message_info.source_name;
+    tick_size = event.value.tick_size;
+  }
+  void operator()(Event<TopOfBook> const &event) override {
+    receive_times.emplace_back(event.message_info.receive_time);
+    layers.emplace_back(event.value.layer);
+  }
+  void operator()(Event<MarketByPriceUpdate> const &event) override {
+    bids.assign(std::begin(event.value.bids), std::end(event.value.bids));
+    asks.assign(std::begin(event.value.asks), std::end(event.value.asks));
+  }
+  void operator()(Event<TradeSummary> const &event) override {
+    for (auto &trade : event.value.trades) {
+      trade_ids.emplace_back(trade.trade_id);
+    }
+  }
+
+  std::string source_name;
+  double tick_size = NaN;
+  std::vector<std::chrono::nanoseconds> receive_times;
+  std::vector<Layer> layers;
+  std::vector<MBPUpdate> bids;
+  std::vector<MBPUpdate> asks;
+  std::vector<std::string> trade_ids;
+};
+
+auto create_message_info(std::chrono::nanoseconds receive_time) {
+  return MessageInfo{
+      .source = 1,
+      .source_name = "deribit"sv,
+      .source_session_id = {},
+      .source_seqno = {},
+      .receive_time_utc = receive_time,
+      .receive_time = receive_time,
+      .source_send_time = {},
+      .source_receive_time = {},
+      .origin_create_time = {},
+      .origin_create_time_utc = {},
+      .is_last = true,
+      .opaque = {},
+  };
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("algo_simulator_event_log_1", "[algo_simulator]") {
+  auto path = fmt::format("/tmp/roq-algo-test-{}.bin"sv, ::getpid());
+  {
+    algo::simulator::EventLogWriter writer{path};
+    auto message_info = create_message_info(1s);
+    auto reference_data = ReferenceData{};
+    reference_data.exchange = "deribit"sv;
+    reference_data.symbol = "BTC-PERPETUAL"sv;
+    reference_data.tick_size = 0.5;
+    writer(Event{message_info, reference_data});
+    for (int i = 0; i < 3; ++i) {
+      auto message_info_2 = create_message_info(2s + std::chrono::nanoseconds{i});
+      auto top_of_book = TopOfBook{};
+      top_of_book.exchange = "deribit"sv;
+      top_of_book.symbol = "BTC-PERPETUAL"sv;
+      top_of_book.layer = {
+          .bid_price = 100.0 + i,
+          .bid_quantity = 1.0,
+          .ask_price = 101.0 + i,
+          .ask_quantity = 2.0,
+      };
+      writer(Event{message_info_2, top_of_book});
+    }
+    auto bids = std::array{
+        MBPUpdate{.price = 100.0, .quantity = 1.0},
+        MBPUpdate{.price = 99.5, .quantity = 2.0},
+    };
+    auto asks = std::array{
+        MBPUpdate{.price = 101.0, .quantity = 3.0},
+    };
+    auto market_by_price_update = MarketByPriceUpdate{};
+    market_by_price_update.exchange = "deribit"sv;
+    market_by_price_update.symbol = "BTC-PERPETUAL"sv;
+    market_by_price_update.bids = bids;
+    market_by_price_update.asks = asks;
+    writer(Event{message_info, market_by_price_update});
+    auto trades = std::array{
+        Trade{.side = Side::BUY, .price = 101.0, .quantity = 1.0, .trade_id = "T1"sv},
+        Trade{.side = Side::SELL, .price = 100.0, .quantity = 1.0, .trade_id = "T2"sv},
+    };
+    auto trade_summary = TradeSummary{};
+    trade_summary.exchange = "deribit"sv;
+    trade_summary.symbol = "BTC-PERPETUAL"sv;
+    trade_summary.trades = trades;
+    writer(Event{message_info, trade_summary});
+  }
+  Strategy strategy;
+  {
+    algo::simulator::EventLogReader reader{path};
+    reader(strategy);
+  }
+  ::unlink(path.c_str());
+  CHECK(strategy.source_name == "deribit"sv);
+  CHECK(strategy.tick_size == 0.5_a);
+  REQUIRE(std::size(strategy.layers) == 3);
+  CHECK(strategy.receive_times[2] == 2s + 2ns);
+  CHECK(strategy.layers[2].bid_price == 102.0_a);
+  CHECK(strategy.layers[2].ask_quantity == 2.0_a);
+  REQUIRE(std::size(strategy.bids) == 2);
+  CHECK(strategy.bids[1].price == 99.5_a);
+  CHECK(strategy.bids[1].quantity == 2.0_a);
+  REQUIRE(std::size(strategy.asks) == 1);
+  CHECK(strategy.asks[0].quantity == 3.0_a);
+  REQUIRE(std::size(strategy.trade_ids) == 2);
+  CHECK(strategy.trade_ids[1] == "T2"sv);
+}
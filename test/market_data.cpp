@@ -0,0 +1,290 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "roq/algo/tools/basic_market_data.hpp"
+#include "roq/algo/tools/market_data.hpp"
+
+using namespace std::literals;
+
+using namespace Catch::literals;
+
+using namespace roq;
+
+// === CONSTANTS ===
+
+namespace {
+auto const EXCHANGE = "deribit"sv;
+auto const SYMBOL = "BTC-PERPETUAL"sv;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! the compile-time specialization must behave exactly like the runtime facade
+template <algo::MarketDataSource market_data_source>
+struct State final {
+  algo::tools::BasicMarketData<market_data_source> basic_market_data{EXCHANGE, SYMBOL};
+  algo::tools::MarketData market_data{EXCHANGE, SYMBOL, market_data_source};
+  std::chrono::nanoseconds time = {};
+
+  template <typename T>
+  bool operator()(T const &value) {
+    auto now = ++time;
+    auto message_info = MessageInfo{
+        .source = {},
+        .source_name = EXCHANGE,
+        .source_session_id = {},
+        .source_seqno = {},
+        .receive_time_utc = now,
+        .receive_time = now,
+        .source_send_time = now,
+        .source_receive_time = now,
+        .origin_create_time = now,
+        .origin_create_time_utc = now,
+        .is_last = true,
+        .opaque = {},
+    };
+    Event event{message_info, value};
+    auto result = basic_market_data(event);
+    CHECK(market_data(event) == result);
+    compare(basic_market_data.top_of_book(), market_data.top_of_book());
+    return result;
+  }
+
+  std::vector<std::pair<double, double>> get_levels(Side side) const {
+    std::vector<std::pair<double, double>> result;
+    basic_market_data.for_each_level(side, [&](auto price, auto quantity) {
+      result.emplace_back(price, quantity);
+      return true;
+    });
+    return result;
+  }
+
+ protected:
+  static void compare(Layer const &lhs, Layer const &rhs) {
+    auto helper = [](auto lhs, auto rhs) {
+      if (std::isnan(lhs)) {
+        CHECK(std::isnan(rhs));
+      } else {
+        CHECK(lhs == rhs);  // note! same input => same output
+      }
+    };
+    helper(lhs.bid_price, rhs.bid_price);
+    helper(lhs.bid_quantity, rhs.bid_quantity);
+    helper(lhs.ask_price, rhs.ask_price);
+    helper(lhs.ask_quantity, rhs.ask_quantity);
+  }
+};
+
+ReferenceData create_reference_data(double tick_size) {
+  return {
+      .stream_id = {},
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .description = {},
+      .security_type = {},
+      .external_security_id = {},
+      .cfi_code = {},
+      .base_currency = {},
+      .quote_currency = {},
+      .settlement_currency = {},
+      .margin_currency = {},
+      .commission_currency = {},
+      .tick_size = tick_size,
+      .tick_size_steps = {},
+      .multiplier = NaN,
+      .min_notional = NaN,
+      .min_trade_vol = 1.0,
+      .max_trade_vol = NaN,
+      .trade_vol_step_size = NaN,
+      .option_type = {},
+      .strike_currency = {},
+      .strike_price = NaN,
+      .underlying = {},
+      .time_zone = {},
+      .issue_date = {},
+      .settlement_date = {},
+      .expiry_datetime = {},
+      .expiry_datetime_utc = {},
+      .exchange_time_utc = {},
+      .exchange_sequence = {},
+      .sending_time_utc = {},
+      .discard = false,
+  };
+}
+
+TopOfBook create_top_of_book(double bid_price, double bid_quantity, double ask_price, double ask_quantity) {
+  return {
+      .stream_id = {},
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .layer{
+          .bid_price = bid_price,
+          .bid_quantity = bid_quantity,
+          .ask_price = ask_price,
+          .ask_quantity = ask_quantity,
+      },
+      .update_type = UpdateType::INCREMENTAL,
+      .exchange_time_utc = {},
+      .exchange_sequence = {},
+      .sending_time_utc = {},
+  };
+}
+
+MBPUpdate create_mbp_update(double price, double quantity) {
+  return {
+      .price = price,
+      .quantity = quantity,
+      .implied_quantity = NaN,
+      .number_of_orders = {},
+      .update_action = {},
+      .price_level = {},
+  };
+}
+
+MarketByPriceUpdate create_market_by_price_update(std::span<MBPUpdate const> const &bids, std::span<MBPUpdate const> const &asks) {
+  return {
+      .stream_id = {},
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .bids = bids,
+      .asks = asks,
+      .update_type = UpdateType::INCREMENTAL,
+      .exchange_time_utc = {},
+      .exchange_sequence = {},
+      .sending_time_utc = {},
+      .price_precision = {},
+      .quantity_precision = {},
+      .max_depth = {},
+      .checksum = {},
+  };
+}
+
+MBOUpdate create_mbo_update(std::string_view const &order_id, Side side, double price, double quantity) {
+  return {
+      .price = price,
+      .quantity = quantity,
+      .priority = {},
+      .order_id = order_id,
+      .side = side,
+      .action = UpdateAction::NEW,
+      .reason = {},
+  };
+}
+
+MarketByOrderUpdate create_market_by_order_update(std::span<MBOUpdate const> const &orders) {
+  return {
+      .stream_id = {},
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .orders = orders,
+      .update_type = UpdateType::INCREMENTAL,
+      .exchange_time_utc = {},
+      .exchange_sequence = {},
+      .sending_time_utc = {},
+      .price_precision = {},
+      .quantity_precision = {},
+      .max_depth = {},
+      .checksum = {},
+  };
+}
+
+// note! bids = {100.0 x 3, 99.9 x 3}, asks = {100.1 x 1}
+auto const BIDS = std::array{
+    create_mbp_update(100.0, 3.0),
+    create_mbp_update(99.9, 3.0),
+};
+auto const ASKS = std::array{
+    create_mbp_update(100.1, 1.0),
+};
+auto const ORDERS = std::array{
+    create_mbo_update("B1"sv, Side::BUY, 100.0, 1.0),
+    create_mbo_update("B2"sv, Side::BUY, 100.0, 2.0),
+    create_mbo_update("B3"sv, Side::BUY, 99.9, 3.0),
+    create_mbo_update("S1"sv, Side::SELL, 100.1, 1.0),
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("algo_tools_basic_market_data_top_of_book", "[algo_tools]") {
+  using MarketData = algo::tools::BasicMarketData<algo::MarketDataSource::TOP_OF_BOOK>;
+  static_assert(MarketData::get_market_data_source() == algo::MarketDataSource::TOP_OF_BOOK);
+  CHECK_THROWS(MarketData(EXCHANGE, SYMBOL, algo::MarketDataSource::MARKET_BY_PRICE));
+  State<algo::MarketDataSource::TOP_OF_BOOK> state;
+  state(create_reference_data(0.1));
+  CHECK(state.basic_market_data.has_tick_size());
+  CHECK(state.basic_market_data.price_to_ticks(100.0) == std::pair<int64_t, bool>{1000, false});
+  CHECK(state(create_top_of_book(100.0, 1.0, 100.2, 2.0)));
+  auto &top_of_book = state.basic_market_data.top_of_book();
+  CHECK(top_of_book.bid_price == 100.0_a);
+  CHECK(top_of_book.ask_price == 100.2_a);
+  // note! ignored
+  CHECK(!state(create_market_by_price_update(BIDS, ASKS)));
+  CHECK(!state(create_market_by_order_update(ORDERS)));
+  CHECK(state.basic_market_data.top_of_book().bid_price == 100.0_a);
+  auto levels = state.get_levels(Side::BUY);
+  REQUIRE(std::size(levels) == 1);
+  CHECK(levels[0].first == 100.0_a);
+  CHECK(levels[0].second == 1.0_a);
+}
+
+TEST_CASE("algo_tools_basic_market_data_market_by_price", "[algo_tools]") {
+  using MarketData = algo::tools::BasicMarketData<algo::MarketDataSource::MARKET_BY_PRICE>;
+  static_assert(MarketData::get_market_data_source() == algo::MarketDataSource::MARKET_BY_PRICE);
+  CHECK_THROWS(MarketData(EXCHANGE, SYMBOL, algo::MarketDataSource::TOP_OF_BOOK));
+  State<algo::MarketDataSource::MARKET_BY_PRICE> state;
+  state(create_reference_data(0.1));
+  CHECK(state.basic_market_data.total_quantity(Side::BUY, 100.0) == 0.0_a);
+  // note! ignored
+  CHECK(!state(create_top_of_book(100.0, 1.0, 100.2, 2.0)));
+  CHECK(std::isnan(state.basic_market_data.top_of_book().bid_price));
+  CHECK(state(create_market_by_price_update(BIDS, ASKS)));
+  auto &top_of_book = state.basic_market_data.top_of_book();
+  CHECK(top_of_book.bid_price == 100.0_a);
+  CHECK(top_of_book.bid_quantity == 3.0_a);
+  CHECK(top_of_book.ask_price == 100.1_a);
+  CHECK(top_of_book.ask_quantity == 1.0_a);
+  CHECK(state.basic_market_data.total_quantity(Side::BUY, 99.9) == 3.0_a);
+  CHECK(state.market_data.total_quantity(Side::BUY, 99.9) == 3.0_a);
+  // note! ignored
+  CHECK(!state(create_market_by_order_update(ORDERS)));
+  auto levels = state.get_levels(Side::BUY);
+  REQUIRE(std::size(levels) == 2);
+  CHECK(levels[0].first == 100.0_a);
+  CHECK(levels[1].first == 99.9_a);
+}
+
+TEST_CASE("algo_tools_basic_market_data_market_by_order", "[algo_tools]") {
+  using MarketData = algo::tools::BasicMarketData<algo::MarketDataSource::MARKET_BY_ORDER>;
+  static_assert(MarketData::get_market_data_source() == algo::MarketDataSource::MARKET_BY_ORDER);
+  CHECK_THROWS(MarketData(EXCHANGE, SYMBOL, algo::MarketDataSource::MARKET_BY_PRICE));
+  State<algo::MarketDataSource::MARKET_BY_ORDER> state;
+  state(create_reference_data(0.1));
+  // note! ignored
+  CHECK(!state(create_top_of_book(100.0, 1.0, 100.2, 2.0)));
+  CHECK(!state(create_market_by_price_update(BIDS, ASKS)));
+  CHECK(std::isnan(state.basic_market_data.top_of_book().bid_price));
+  CHECK(state(create_market_by_order_update(ORDERS)));
+  auto &top_of_book = state.basic_market_data.top_of_book();
+  CHECK(top_of_book.bid_price == 100.0_a);
+  CHECK(top_of_book.bid_quantity == 3.0_a);
+  CHECK(top_of_book.ask_price == 100.1_a);
+  CHECK(top_of_book.ask_quantity == 1.0_a);
+  CHECK(state.basic_market_data.total_quantity(Side::BUY, 100.0) == 3.0_a);
+  CHECK(state.market_data.total_quantity(Side::BUY, 100.0) == 3.0_a);
+  auto levels = state.get_levels(Side::BUY);
+  REQUIRE(std::size(levels) == 2);
+  CHECK(levels[0].first == 100.0_a);
+  CHECK(levels[0].second == 3.0_a);
+  CHECK(levels[1].first == 99.9_a);
+  CHECK(levels[1].second == 3.0_a);
+}
@@ -6,7 +6,11 @@
 
 #include "roq/utils/container.hpp"
 
+#include "roq/algo/matcher/basic_simple.hpp"
 #include "roq/algo/matcher/factory.hpp"
+#include "roq/algo/matcher/group.hpp"
+
+#include "roq/algo/matcher/adaptor.hpp"
 
 using namespace std::literals;
 
@@ -62,6 +66,8 @@ struct OrderCache final : public algo::OrderCache {
     return true;
   }
 
+  uint64_t get_next_trade_id() override { return ++next_trade_id_; }
+
  protected:
   cache::Order *get_order_helper(uint64_t order_id) override {
     auto iter = orders_.find(order_id);
@@ -70,7 +76,6 @@ struct OrderCache final : public algo::OrderCache {
     }
     return nullptr;
   }
-  uint64_t get_next_trade_id() override { return ++next_trade_id_; }
 
  private:
   utils::unordered_map<uint64_t, cache::Order> orders_;
@@ -78,6 +83,8 @@ struct OrderCache final : public algo::OrderCache {
 };
 
 struct Dispatcher final : public algo::Matcher::Dispatcher {
+  void set(std::function<void(algo::Matcher::Sweep const &)> sweep) { sweep_ = sweep; }
+
   void set(std::function<void(OrderUpdate const &)> order_update, std::function<void(TradeUpdate const &)> trade_update) {
     order_update_ = order_update;
     trade_update_ = trade_update;
@@ -92,14 +99,28 @@ struct Dispatcher final : public algo::Matcher::Dispatcher {
     trade_update_ = trade_update;
   }
 
+  void set(std::function<void(CancelAllOrdersAck const &)> cancel_all_orders_ack, std::function<void(algo::Matcher::Batch const &)> batch) {
+    cancel_all_orders_ack_ = cancel_all_orders_ack;
+    batch_ = batch;
+  }
+
+  void set(std::function<void(MassQuoteAck const &)> mass_quote_ack) { mass_quote_ack_ = mass_quote_ack; }
+
+  void set(std::function<void(CancelQuotesAck const &)> cancel_quotes_ack) { cancel_quotes_ack_ = cancel_quotes_ack; }
+
   void reset() {
     order_ack_ = {};
     order_update_ = {};
     trade_update_ = {};
+    cancel_all_orders_ack_ = {};
+    batch_ = {};
+    mass_quote_ack_ = {};
+    cancel_quotes_ack_ = {};
+    sweep_ = {};
   }
 
   bool empty() const {
-    if (!order_ack_ && !order_update_ && !trade_update_) {
+    if (!order_ack_ && !order_update_ && !trade_update_ && !cancel_all_orders_ack_ && !batch_ && !mass_quote_ack_ && !cancel_quotes_ack_ && !sweep_) {
       return true;
     }
     if (order_ack_) {
@@ -111,10 +132,25 @@ struct Dispatcher final : public algo::Matcher::Dispatcher {
     if (trade_update_) {
       log::error("MISSING: trade_update"sv);
     }
+    if (cancel_all_orders_ack_) {
+      log::error("MISSING: cancel_all_orders_ack"sv);
+    }
+    if (batch_) {
+      log::error("MISSING: batch"sv);
+    }
+    if (mass_quote_ack_) {
+      log::error("MISSING: mass_quote_ack"sv);
+    }
+    if (cancel_quotes_ack_) {
+      log::error("MISSING: cancel_quotes_ack"sv);
+    }
+    if (sweep_) {
+      log::error("MISSING: sweep"sv);
+    }
     return false;
   }
 
- protected:
+  // note! public so the header-only matcher can dispatch directly (static dispatch)
   void operator()(Event<ReferenceData> const &) override {}
   void operator()(Event<MarketStatus> const &) override {}
   void operator()(Event<TopOfBook> const &) override {}
@@ -146,13 +182,56 @@ struct Dispatcher final : public algo::Matcher::Dispatcher {
       log::error("UNEXPECTED: trade_update"sv);
     }
   }
-  void operator()(Event<MassQuoteAck> const &) override {}
-  void operator()(Event<CancelQuotesAck> const &) override {}
+  void operator()(Event<CancelAllOrdersAck> const &event) override {
+    if (cancel_all_orders_ack_) {
+      cancel_all_orders_ack_(event.value);
+      cancel_all_orders_ack_ = {};
+    } else {
+      log::error("UNEXPECTED: cancel_all_orders_ack"sv);
+    }
+  }
+  void operator()(Event<MassQuoteAck> const &event) override {
+    if (mass_quote_ack_) {
+      mass_quote_ack_(event.value);
+      mass_quote_ack_ = {};
+    } else {
+      log::error("UNEXPECTED: mass_quote_ack"sv);
+    }
+  }
+  void operator()(Event<CancelQuotesAck> const &event) override {
+    if (cancel_quotes_ack_) {
+      cancel_quotes_ack_(event.value);
+      cancel_quotes_ack_ = {};
+    } else {
+      log::error("UNEXPECTED: cancel_quotes_ack"sv);
+    }
+  }
+  void operator()(Event<algo::Matcher::Sweep> const &event) override {
+    if (sweep_) {
+      sweep_(event.value);
+      sweep_ = {};
+    } else {
+      algo::Matcher::Dispatcher::operator()(event);  // note! default implementation
+    }
+  }
+  void operator()(Event<algo::Matcher::Batch> const &event) override {
+    if (batch_) {
+      batch_(event.value);
+      batch_ = {};
+    } else {
+      algo::Matcher::Dispatcher::operator()(event);  // note! default implementation
+    }
+  }
 
  private:
   std::function<void(OrderAck const &)> order_ack_;
   std::function<void(OrderUpdate const &)> order_update_;
   std::function<void(TradeUpdate const &)> trade_update_;
+  std::function<void(CancelAllOrdersAck const &)> cancel_all_orders_ack_;
+  std::function<void(algo::Matcher::Batch const &)> batch_;
+  std::function<void(MassQuoteAck const &)> mass_quote_ack_;
+  std::function<void(CancelQuotesAck const &)> cancel_quotes_ack_;
+  std::function<void(algo::Matcher::Sweep const &)> sweep_;
 };
 
 struct State2 final {
@@ -172,6 +251,8 @@ struct State2 final {
 struct Helper final {
   explicit Helper(State2 &state) : state_{state} {}
 
+  Helper(State2 &state, std::function<void(algo::Matcher::Sweep const &)> sweep) : state_{state} { state_.dispatcher.set(sweep); }
+
   Helper(State2 &state, std::function<void(OrderUpdate const &)> order_update, std::function<void(TradeUpdate const &)> trade_update) : state_{state} {
     state_.dispatcher.set(order_update, trade_update);
   }
@@ -247,7 +328,46 @@ struct Helper final {
     dispatch(top_of_book);
   };
 
-  uint64_t create_order(Side side, OrderType order_type, TimeInForce time_in_force, double quantity, double price) {
+  void market_by_price(std::span<MBPUpdate const> const &bids, std::span<MBPUpdate const> const &asks, UpdateType update_type) {
+    auto market_by_price_update = MarketByPriceUpdate{
+        .stream_id = {},
+        .exchange = state_.exchange,
+        .symbol = state_.symbol,
+        .bids = bids,
+        .asks = asks,
+        .update_type = update_type,
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+        .price_precision = {},
+        .quantity_precision = {},
+        .max_depth = {},
+        .checksum = {},
+    };
+    dispatch(market_by_price_update);
+  };
+
+  void trade_summary(Side side, double price, double quantity) {
+    auto trade = Trade{
+        .side = side,
+        .price = price,
+        .quantity = quantity,
+        .trade_id = {},
+    };
+    auto trade_summary = TradeSummary{
+        .stream_id = {},
+        .exchange = state_.exchange,
+        .symbol = state_.symbol,
+        .trades = {&trade, 1},
+        .exchange_time_utc = {},
+        .exchange_sequence = {},
+        .sending_time_utc = {},
+    };
+    dispatch(trade_summary);
+  };
+
+  uint64_t create_order(
+      Side side, OrderType order_type, TimeInForce time_in_force, double quantity, double price, Mask<ExecutionInstruction> execution_instructions = {}) {
     auto create_order = CreateOrder{
         .account = state_.account,
         .order_id = ++state_.next_order_id,
@@ -260,7 +380,7 @@ struct Helper final {
         .max_show_quantity = NaN,
         .order_type = order_type,
         .time_in_force = time_in_force,
-        .execution_instructions = {},
+        .execution_instructions = execution_instructions,
         .request_template = {},
         .quantity = quantity,
         .price = price,
@@ -302,6 +422,57 @@ struct Helper final {
     dispatch(cancel_order);
   };
 
+  void cancel_all_orders(
+      Side side,
+      std::function<void(CancelAllOrdersAck const &)> cancel_all_orders_ack,
+      std::function<void(algo::Matcher::Batch const &)> batch,
+      std::string_view const &symbol = {}) {
+    state_.dispatcher.set(cancel_all_orders_ack, batch);
+    auto cancel_all_orders = CancelAllOrders{
+        .account = state_.account,
+        .order_id = {},
+        .exchange = state_.exchange,
+        .symbol = std::empty(symbol) ? state_.symbol : symbol,
+        .strategy_id = {},
+        .side = side,
+    };
+    dispatch(cancel_all_orders);
+  }
+
+  void mass_quote(
+      std::span<MBPUpdate const> const &bids, std::span<MBPUpdate const> const &asks, std::function<void(MassQuoteAck const &)> mass_quote_ack) {
+    auto quote = Quote{
+        .exchange = state_.exchange,
+        .symbol = state_.symbol,
+        .bids = bids,
+        .asks = asks,
+    };
+    mass_quote({&quote, 1}, mass_quote_ack);
+  }
+
+  void mass_quote(std::span<Quote const> const &quotes, std::function<void(MassQuoteAck const &)> mass_quote_ack) {
+    state_.dispatcher.set(mass_quote_ack);
+    auto mass_quote = MassQuote{
+        .account = state_.account,
+        .quote_id = {},
+        .quotes = quotes,
+        .strategy_id = {},
+    };
+    dispatch(mass_quote);
+  }
+
+  void cancel_quotes(std::function<void(CancelQuotesAck const &)> cancel_quotes_ack) {
+    state_.dispatcher.set(cancel_quotes_ack);
+    auto cancel_quotes = CancelQuotes{
+        .account = state_.account,
+        .quote_id = {},
+        .exchange = state_.exchange,
+        .symbol = state_.symbol,
+        .strategy_id = {},
+    };
+    dispatch(cancel_quotes);
+  }
+
  protected:
   template <typename T>
   void dispatch(T const &value) {
@@ -605,3 +776,1474 @@ TEST_CASE("algo_matcher_modify_2", "[algo_matcher]") {
     CHECK(order.average_traded_price == 101.0_a);
   }));
 }
+
+TEST_CASE("algo_matcher_simple_price_ladder_1", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(algo::matcher::Type::SIMPLE_PRICE_LADDER, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 102.0, 1.0);
+  // t=3
+  auto order_id_1 = Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+      {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 1.0, 101.0);
+  REQUIRE(order_id_1 > 0);
+  // t=4
+  // note! far away from the first order (forces the ladder to re-anchor)
+  auto order_id_2 = Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+      {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 1.0, 150.0);
+  REQUIRE(order_id_2 > 0);
+  // t=5
+  Helper{
+      state,
+      [&](auto &order_update) {
+        CHECK(order_update.order_id == order_id_1);
+        CHECK(order_update.order_status == OrderStatus::COMPLETED);
+        CHECK(order_update.average_traded_price == 101.0_a);
+      },
+      [&](auto &trade_update) {
+        CHECK(trade_update.side == Side::SELL);
+        REQUIRE(!std::empty(trade_update.fills));
+        for (auto &item : trade_update.fills) {
+          CHECK(item.price == 101.0_a);
+          CHECK(item.liquidity == Liquidity::MAKER);
+        }
+      }}
+      .top_of_book(101.0, 1.0, 102.0, 1.0);
+  REQUIRE(state.order_cache.find(order_id_1, [&](auto &order) { CHECK(order.order_status == OrderStatus::COMPLETED); }));
+  REQUIRE(state.order_cache.find(order_id_2, [&](auto &order) { CHECK(order.order_status == OrderStatus::WORKING); }));
+}
+
+TEST_CASE("algo_matcher_price_ladder_1", "[algo_matcher]") {
+  struct Order final {
+    uint64_t order_id = {};
+    int64_t price = {};
+  };
+  algo::matcher::PriceLadder<Order> orders{Side::SELL};
+  auto match = [&](int64_t price) {
+    std::vector<uint64_t> result;
+    orders.match(price, [&](auto &order) { result.emplace_back(order.order_id); });
+    return result;
+  };
+  // note! sparse (the best price is found by skipping empty levels)
+  orders.add({.order_id = 1, .price = 100});
+  orders.add({.order_id = 2, .price = 100'000});
+  orders.add({.order_id = 3, .price = 100});
+  CHECK(orders.remove(1));
+  CHECK(match(100) == std::vector<uint64_t>{3});
+  CHECK(std::empty(match(99'999)));
+  CHECK(match(100'000) == std::vector<uint64_t>{2});
+  CHECK(orders.empty());
+  // note! range exceeds capacity => degrades (priority is preserved)
+  orders.add({.order_id = 4, .price = 100});
+  orders.add({.order_id = 5, .price = 100});
+  orders.add({.order_id = 6, .price = 10'000'000});
+  orders.add({.order_id = 7, .price = 99});
+  CHECK(orders.size() == 4);
+  CHECK(orders.move({.order_id = 4, .price = 100}));
+  CHECK(match(100) == (std::vector<uint64_t>{7, 5, 4}));
+  CHECK(orders.remove(6));
+  CHECK(orders.empty());
+  // note! rescale exceeding capacity => degrades
+  orders.add({.order_id = 8, .price = 100'000});
+  orders.add({.order_id = 9, .price = 100});
+  orders.rescale(100);
+  CHECK(orders.size() == 2);
+  CHECK(match(10'000) == std::vector<uint64_t>{9});
+  CHECK(match(10'000'000) == std::vector<uint64_t>{8});
+  // note! back to the ladder
+  orders.add({.order_id = 10, .price = 101});
+  CHECK(match(101) == std::vector<uint64_t>{10});
+}
+
+TEST_CASE("algo_matcher_cancel_1", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 102.0, 1.0);
+  // t=3
+  auto order_id = Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+      {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.0);
+  REQUIRE(order_id > 0);
+  // t=4
+  Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::CANCELED); },
+      {}}
+      .cancel_order(order_id);
+  // t=5
+  // note! would have matched the resting order
+  Helper{state}.top_of_book(98.0, 1.0, 100.0, 1.0);
+  REQUIRE(state.order_cache.find(order_id, [&](auto &order) {
+    CHECK(order.order_status == OrderStatus::CANCELED);
+    CHECK(order.remaining_quantity == 1.0_a);
+    CHECK(order.traded_quantity == 0.0_a);
+  }));
+}
+
+TEST_CASE("algo_matcher_sweep_1", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=3-5
+  std::vector<uint64_t> order_ids;
+  for (auto price : {103.0, 101.0, 102.0}) {
+    auto order_id = Helper{
+        state,
+        [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+        [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+        {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 1.0, price);
+    order_ids.emplace_back(order_id);
+  }
+  // t=6
+  // note! one market data event crossing all resting orders => one sweep (in priority order)
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 3);
+        REQUIRE(std::size(sweep.trade_updates) == 3);
+        CHECK(sweep.order_updates[0].order_id == order_ids[1]);
+        CHECK(sweep.order_updates[1].order_id == order_ids[2]);
+        CHECK(sweep.order_updates[2].order_id == order_ids[0]);
+        for (size_t i = 0; i < std::size(sweep.order_updates); ++i) {
+          CHECK(sweep.order_updates[i].order_status == OrderStatus::COMPLETED);
+          CHECK(sweep.trade_updates[i].order_id == sweep.order_updates[i].order_id);
+          REQUIRE(std::size(sweep.trade_updates[i].fills) == 1);
+          CHECK(sweep.trade_updates[i].fills[0].price == sweep.order_updates[i].price);
+          CHECK(sweep.trade_updates[i].fills[0].liquidity == Liquidity::MAKER);
+        }
+      }}
+      .top_of_book(103.0, 1.0, 104.0, 1.0);
+  for (auto order_id : order_ids) {
+    REQUIRE(state.order_cache.find(order_id, [&](auto &order) { CHECK(order.order_status == OrderStatus::COMPLETED); }));
+  }
+}
+
+TEST_CASE("algo_matcher_basic_simple_1", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  // note! concrete dispatcher, order cache and market data (static dispatch), only the outer layer is virtual
+  using MarketData = algo::tools::BasicMarketData<algo::MarketDataSource::TOP_OF_BOOK>;
+  algo::matcher::Adaptor<algo::matcher::BasicSimple<algo::matcher::PriceLadder, Dispatcher, OrderCache, MarketData>> matcher{dispatcher, order_cache, config};
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=3
+  auto order_id = Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+      {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 1.0, 103.0);
+  REQUIRE(order_id > 0);
+  // t=4
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        REQUIRE(std::size(sweep.trade_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::COMPLETED);
+        REQUIRE(std::size(sweep.trade_updates[0].fills) == 1);
+        CHECK(sweep.trade_updates[0].fills[0].price == 103.0_a);
+        CHECK(sweep.trade_updates[0].fills[0].liquidity == Liquidity::MAKER);
+      }}
+      .top_of_book(103.0, 1.0, 104.0, 1.0);
+  // t=5
+  auto order_id_2 = Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) {
+        CHECK(order_update.order_status == OrderStatus::COMPLETED);
+        CHECK(order_update.average_traded_price == 104.0_a);
+      },
+      [&](auto &trade_update) {
+        REQUIRE(std::size(trade_update.fills) == 1);
+        CHECK(trade_update.fills[0].price == 104.0_a);
+        CHECK(trade_update.fills[0].liquidity == Liquidity::TAKER);
+      }}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 104.0);
+  REQUIRE(state.order_cache.find(order_id_2, [&](auto &order) { CHECK(order.order_status == OrderStatus::COMPLETED); }));
+}
+
+TEST_CASE("algo_matcher_queue_position_simple_1", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::QUEUE_POSITION_SIMPLE, algo::matcher::Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  auto bids_1 = std::array{create_mbp_update(100.0, 5.0)};
+  auto asks_1 = std::array{create_mbp_update(102.0, 5.0)};
+  Helper{state}.market_by_price(bids_1, asks_1, UpdateType::SNAPSHOT);
+  // t=3
+  // note! 5.0 ahead
+  auto order_id = Helper{
+      state,
+      [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+      {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.0);
+  REQUIRE(order_id > 0);
+  // t=4
+  // note! quote => min (3.0 ahead)
+  auto bids_2 = std::array{create_mbp_update(100.0, 3.0)};
+  Helper{state}.market_by_price(bids_2, {}, UpdateType::INCREMENTAL);
+  // t=5
+  // note! trade => reduce (1.0 ahead)
+  Helper{state}.trade_summary(Side::SELL, 100.0, 2.0);
+  REQUIRE(state.order_cache.find(order_id, [&](auto &order) {
+    CHECK(order.order_status == OrderStatus::WORKING);
+    CHECK(order.remaining_quantity == 1.0_a);
+  }));
+  // t=6
+  // note! trade => reduce (excess 0.5 => partial fill)
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::WORKING);
+        CHECK(sweep.order_updates[0].remaining_quantity == 0.5_a);
+        CHECK(sweep.order_updates[0].traded_quantity == 0.5_a);
+        REQUIRE(std::size(sweep.trade_updates[0].fills) == 1);
+        CHECK(sweep.trade_updates[0].fills[0].quantity == 0.5_a);
+        CHECK(sweep.trade_updates[0].fills[0].price == 100.0_a);
+        CHECK(sweep.trade_updates[0].fills[0].liquidity == Liquidity::MAKER);
+      }}
+      .trade_summary(Side::SELL, 100.0, 1.5);
+  // t=7
+  // note! trading through the price level => filled
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::COMPLETED);
+        CHECK(sweep.order_updates[0].remaining_quantity == 0.0_a);
+        CHECK(sweep.order_updates[0].traded_quantity == 1.0_a);
+        CHECK(sweep.order_updates[0].average_traded_price == 100.0_a);
+        REQUIRE(std::size(sweep.trade_updates[0].fills) == 1);
+        CHECK(sweep.trade_updates[0].fills[0].quantity == 0.5_a);
+      }}
+      .trade_summary(Side::SELL, 99.9, 1.0);
+  REQUIRE(state.order_cache.find(order_id, [&](auto &order) { CHECK(order.order_status == OrderStatus::COMPLETED); }));
+}
+
+TEST_CASE("algo_matcher_mass_quote_1", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto accepted = [](auto &ack) { CHECK(ack.request_status == RequestStatus::ACCEPTED); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=3
+  auto bids_1 = std::array{create_mbp_update(101.0, 1.0), create_mbp_update(100.5, 2.0)};
+  auto asks_1 = std::array{create_mbp_update(103.0, 1.0)};
+  Helper{state}.mass_quote(bids_1, asks_1, accepted);
+  // t=4
+  // note! replace => quantity (in place), price (moved) and surplus level (removed)
+  auto bids_2 = std::array{create_mbp_update(101.0, 3.0)};
+  auto asks_2 = std::array{create_mbp_update(102.0, 2.0)};
+  Helper{state}.mass_quote(bids_2, asks_2, accepted);
+  // t=5
+  // note! crossing the market => rejected and nothing changes (atomic)
+  auto asks_3 = std::array{create_mbp_update(100.0, 1.0)};
+  Helper{state}.mass_quote(bids_2, asks_3, [](auto &mass_quote_ack) {
+    CHECK(mass_quote_ack.request_status == RequestStatus::REJECTED);
+    CHECK(mass_quote_ack.error == Error::INVALID_PRICE);
+  });
+  // t=6
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(algo::matcher::Quotes::is_quote(sweep.order_updates[0].order_id));
+        CHECK(sweep.order_updates[0].side == Side::SELL);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::COMPLETED);
+        REQUIRE(std::size(sweep.trade_updates[0].fills) == 1);
+        CHECK(sweep.trade_updates[0].fills[0].quantity == 2.0_a);
+        CHECK(sweep.trade_updates[0].fills[0].price == 102.0_a);
+        CHECK(sweep.trade_updates[0].fills[0].liquidity == Liquidity::MAKER);
+      }}
+      .top_of_book(102.0, 1.0, 104.0, 1.0);
+  // t=7
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=8
+  // note! filled level is re-added
+  Helper{state}.mass_quote(bids_2, asks_2, accepted);
+  // t=9
+  Helper{state}.cancel_quotes(accepted);
+  // t=10
+  // note! no resting quotes => no sweep
+  Helper{state}.top_of_book(100.0, 1.0, 101.0, 1.0);
+  // t=11
+  Helper{state}.top_of_book(102.0, 1.0, 104.0, 1.0);
+}
+
+TEST_CASE("algo_matcher_mass_quote_2", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto accepted = [](auto &ack) { CHECK(ack.request_status == RequestStatus::ACCEPTED); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=3
+  // note! first quote => all levels are new
+  auto bids = std::array{create_mbp_update(101.0, 1.0), create_mbp_update(100.5, 2.0)};
+  auto asks = std::array{create_mbp_update(103.0, 1.0)};
+  Helper{state}.mass_quote(bids, asks, accepted);
+  // t=4
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(algo::matcher::Quotes::is_quote(sweep.order_updates[0].order_id));
+        CHECK(sweep.order_updates[0].side == Side::SELL);
+        CHECK(sweep.order_updates[0].price == 103.0_a);
+      }}
+      .top_of_book(103.0, 1.0, 104.0, 1.0);
+  // t=5
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 2);
+        CHECK(sweep.order_updates[0].side == Side::BUY);
+        CHECK(sweep.order_updates[0].price == 101.0_a);
+        CHECK(sweep.order_updates[1].side == Side::BUY);
+        CHECK(sweep.order_updates[1].price == 100.5_a);
+      }}
+      .top_of_book(99.0, 1.0, 100.0, 1.0);
+}
+
+TEST_CASE("algo_matcher_mass_quote_3", "[algo_matcher]") {
+  auto type = GENERATE(
+      algo::matcher::Type::SIMPLE,
+      algo::matcher::Type::SIMPLE_PRICE_LADDER,
+      algo::matcher::Type::QUEUE_POSITION_SIMPLE,
+      algo::matcher::Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  size_t count = {};
+  auto rejected = [&](auto &ack) {
+    ++count;
+    CHECK(ack.request_status == RequestStatus::REJECTED);
+    CHECK(ack.error == Error::INVALID_SYMBOL);
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  // note! not for this instrument => rejected (exactly one ack)
+  auto state_2 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = "XYZ"sv,
+      .time = state.time,
+  };
+  auto bids = std::array{create_mbp_update(100.0, 1.0)};
+  Helper{state_2}.mass_quote(bids, {}, rejected);
+  CHECK(count == 1);
+  // t=3
+  Helper{state_2}.cancel_quotes(rejected);
+  CHECK(count == 2);
+}
+
+TEST_CASE("algo_matcher_cancel_all_1", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=3-6
+  std::vector<uint64_t> order_ids;
+  for (auto [side, price] : {std::pair{Side::BUY, 101.0}, {Side::BUY, 99.0}, {Side::SELL, 103.0}, {Side::SELL, 105.0}}) {
+    auto order_id = Helper{
+        state,
+        [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); },
+        [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); },
+        {}}.create_order(side, OrderType::LIMIT, TimeInForce::GTC, 1.0, price);
+    order_ids.emplace_back(order_id);
+  }
+  // t=7
+  // note! side filter => only buy orders
+  Helper{state}.cancel_all_orders(
+      Side::BUY,
+      [&](auto &cancel_all_orders_ack) {
+        CHECK(cancel_all_orders_ack.request_status == RequestStatus::ACCEPTED);
+        CHECK(cancel_all_orders_ack.number_of_affected_orders == 2);
+      },
+      [&](auto &batch) {
+        REQUIRE(std::size(batch.order_updates) == 2);
+        for (auto &order_update : batch.order_updates) {
+          CHECK(order_update.side == Side::BUY);
+          CHECK(order_update.order_status == OrderStatus::CANCELED);
+        }
+      });
+  // t=8
+  // note! not for this instrument => rejected, nothing is canceled
+  Helper{state}.cancel_all_orders(
+      {},
+      [&](auto &cancel_all_orders_ack) {
+        CHECK(cancel_all_orders_ack.request_status == RequestStatus::REJECTED);
+        CHECK(cancel_all_orders_ack.error == Error::INVALID_SYMBOL);
+        CHECK(cancel_all_orders_ack.symbol == "ETH-PERPETUAL"sv);
+        CHECK(cancel_all_orders_ack.number_of_affected_orders == 0);
+      },
+      {},
+      "ETH-PERPETUAL"sv);
+  // t=9
+  Helper{state}.cancel_all_orders(
+      {},
+      [&](auto &cancel_all_orders_ack) { CHECK(cancel_all_orders_ack.number_of_affected_orders == 2); },
+      [&](auto &batch) { REQUIRE(std::size(batch.order_updates) == 2); });
+  for (auto order_id : order_ids) {
+    REQUIRE(state.order_cache.find(order_id, [&](auto &order) { CHECK(order.order_status == OrderStatus::CANCELED); }));
+  }
+  // t=10
+  // note! nothing left => acknowledged, but no batch
+  Helper{state}.cancel_all_orders({}, [&](auto &cancel_all_orders_ack) { CHECK(cancel_all_orders_ack.number_of_affected_orders == 0); }, {});
+  // t=11
+  // note! nothing left => no sweep
+  Helper{state}.top_of_book(106.0, 1.0, 107.0, 1.0);
+}
+
+TEST_CASE("algo_matcher_modify_3", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 104.0, 1.0);
+  // t=3-5
+  std::vector<uint64_t> order_ids;
+  for (size_t i = 0; i < 3; ++i) {
+    auto order_id = Helper{state, accepted, working, {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 2.0, 103.0);
+    order_ids.emplace_back(order_id);
+  }
+  // t=6
+  // note! quantity down => queue position is kept
+  Helper{state, accepted, working, {}}.modify_order(order_ids[0], 1.0, NaN);
+  // t=7
+  // note! quantity up => moved to the back of the price level
+  Helper{state, accepted, working, {}}.modify_order(order_ids[1], 3.0, NaN);
+  // t=8
+  // note! price change (and back again) => moved to the back of the price level
+  Helper{state, accepted, working, {}}.modify_order(order_ids[2], NaN, 103.5);
+  // t=9
+  Helper{state, accepted, working, {}}.modify_order(order_ids[2], NaN, 103.0);
+  // t=10
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 3);
+        CHECK(sweep.order_updates[0].order_id == order_ids[0]);
+        CHECK(sweep.order_updates[1].order_id == order_ids[1]);
+        CHECK(sweep.order_updates[2].order_id == order_ids[2]);
+        CHECK(sweep.trade_updates[0].fills[0].quantity == 1.0_a);
+        CHECK(sweep.trade_updates[1].fills[0].quantity == 3.0_a);
+        CHECK(sweep.trade_updates[2].fills[0].quantity == 2.0_a);
+      }}
+      .top_of_book(103.5, 1.0, 104.0, 1.0);
+}
+
+TEST_CASE("algo_matcher_queue_position_simple_2", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::QUEUE_POSITION_SIMPLE, algo::matcher::Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  auto bids_1 = std::array{create_mbp_update(100.0, 5.0)};
+  auto asks_1 = std::array{create_mbp_update(102.0, 5.0)};
+  Helper{state}.market_by_price(bids_1, asks_1, UpdateType::SNAPSHOT);
+  // t=3
+  // note! 5.0 ahead
+  auto order_id = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 2.0, 100.0);
+  // t=4
+  // note! trade => reduce (1.0 ahead)
+  Helper{state}.trade_summary(Side::SELL, 100.0, 4.0);
+  // t=5
+  // note! quantity down => quantity ahead is kept
+  Helper{state, accepted, working, {}}.modify_order(order_id, 1.0, NaN);
+  // t=6
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::COMPLETED);
+        CHECK(sweep.trade_updates[0].fills[0].quantity == 1.0_a);
+      }}
+      .trade_summary(Side::SELL, 100.0, 2.0);
+  // t=7
+  Helper{state, [&](auto &order_ack) { CHECK(order_ack.error == Error::TOO_LATE_TO_MODIFY_OR_CANCEL); }, {}, {}}.modify_order(order_id, 2.0, NaN);
+}
+
+TEST_CASE("algo_matcher_queue_position_simple_3", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::QUEUE_POSITION_SIMPLE, algo::matcher::Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  auto asks = std::array{create_mbp_update(102.0, 5.0)};
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  auto bids_1 = std::array{create_mbp_update(100.0, 5.0), create_mbp_update(99.0, 5.0)};
+  Helper{state}.market_by_price(bids_1, asks, UpdateType::SNAPSHOT);
+  // t=3
+  // note! 5.0 ahead (both)
+  auto order_id_1 = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 2.0, 100.0);
+  auto order_id_2 = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 2.0, 99.0);
+  // t=4
+  // note! update => min (3.0 ahead of the second order, also after the level has grown)
+  auto bids_2 = std::array{create_mbp_update(99.0, 3.0)};
+  Helper{state}.market_by_price(bids_2, {}, UpdateType::INCREMENTAL);
+  auto bids_3 = std::array{create_mbp_update(99.0, 6.0)};
+  Helper{state}.market_by_price(bids_3, {}, UpdateType::INCREMENTAL);
+  // t=5
+  // note! snapshot => all orders are refreshed (2.0 ahead of the first order, the second order is unchanged)
+  auto bids_4 = std::array{create_mbp_update(100.0, 2.0), create_mbp_update(99.0, 6.0)};
+  Helper{state}.market_by_price(bids_4, asks, UpdateType::SNAPSHOT);
+  // t=6
+  // note! trade => 1.0 in excess of the quantity ahead of the first order
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id_1);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::WORKING);
+        REQUIRE(std::size(sweep.trade_updates) == 1);
+        REQUIRE(std::size(sweep.trade_updates[0].fills) == 1);
+        CHECK(sweep.trade_updates[0].fills[0].quantity == 1.0_a);
+      }}
+      .trade_summary(Side::SELL, 100.0, 3.0);
+  // t=7
+  // note! trading through the first order (filled) and 1.0 in excess of the quantity ahead of the second order
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 2);
+        CHECK(sweep.order_updates[0].order_id == order_id_1);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::COMPLETED);
+        CHECK(sweep.order_updates[1].order_id == order_id_2);
+        CHECK(sweep.order_updates[1].order_status == OrderStatus::WORKING);
+        REQUIRE(std::size(sweep.trade_updates) == 2);
+        REQUIRE(std::size(sweep.trade_updates[1].fills) == 1);
+        CHECK(sweep.trade_updates[1].fills[0].quantity == 1.0_a);
+      }}
+      .trade_summary(Side::SELL, 99.0, 4.0);
+}
+
+TEST_CASE("algo_matcher_depth_1", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(algo::matcher::Type::SIMPLE, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  auto bids_1 = std::array{create_mbp_update(100.0, 5.0)};
+  auto asks_1 = std::array{create_mbp_update(102.0, 1.0), create_mbp_update(102.5, 2.0), create_mbp_update(103.0, 5.0)};
+  Helper{state}.market_by_price(bids_1, asks_1, UpdateType::SNAPSHOT);
+  // t=3
+  // note! walks two price levels
+  Helper{
+      state,
+      accepted,
+      [&](auto &order_update) {
+        CHECK(order_update.order_status == OrderStatus::COMPLETED);
+        CHECK(order_update.traded_quantity == 2.5_a);
+        CHECK(order_update.average_traded_price == 102.3_a);
+      },
+      [&](auto &trade_update) {
+        REQUIRE(std::size(trade_update.fills) == 2);
+        CHECK(trade_update.fills[0].quantity == 1.0_a);
+        CHECK(trade_update.fills[0].price == 102.0_a);
+        CHECK(trade_update.fills[0].liquidity == Liquidity::TAKER);
+        CHECK(trade_update.fills[1].quantity == 1.5_a);
+        CHECK(trade_update.fills[1].price == 102.5_a);
+      }}
+      .create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 2.5, 102.5);
+  // t=4
+  // note! liquidity taken at t=3 is depleted and the limit price stops the walk => remaining quantity is resting
+  auto order_id = Helper{
+      state,
+      accepted,
+      [&](auto &order_update) {
+        CHECK(order_update.order_status == OrderStatus::WORKING);
+        CHECK(order_update.remaining_quantity == 3.5_a);
+        CHECK(order_update.traded_quantity == 0.5_a);
+      },
+      [&](auto &trade_update) {
+        REQUIRE(std::size(trade_update.fills) == 1);
+        CHECK(trade_update.fills[0].quantity == 0.5_a);
+        CHECK(trade_update.fills[0].price == 102.5_a);
+      }}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 4.0, 102.5);
+  REQUIRE(state.order_cache.find(order_id, [&](auto &order) { CHECK(order.price == 102.5_a); }));
+  // t=5
+  // note! nothing left up to the limit price
+  Helper{
+      state,
+      accepted,
+      [&](auto &order_update) {
+        CHECK(order_update.order_status == OrderStatus::CANCELED);
+        CHECK(order_update.traded_quantity == 0.0_a);
+      },
+      {}}
+      .create_order(Side::BUY, OrderType::LIMIT, TimeInForce::IOC, 1.0, 102.5);
+  // t=6
+  // note! best price changes, but the (unchanged) price level at the limit price is still depleted => no maker fill
+  auto asks_2 = std::array{create_mbp_update(102.0, 0.0)};
+  Helper{state}.market_by_price({}, asks_2, UpdateType::INCREMENTAL);
+  // t=7
+  // note! price level has been updated => liquidity is available again
+  auto asks_3 = std::array{create_mbp_update(102.5, 3.0)};
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id);
+        CHECK(sweep.order_updates[0].order_status == OrderStatus::COMPLETED);
+        REQUIRE(std::size(sweep.trade_updates) == 1);
+        REQUIRE(std::size(sweep.trade_updates[0].fills) == 1);
+        CHECK(sweep.trade_updates[0].fills[0].price == 102.5_a);
+        CHECK(sweep.trade_updates[0].fills[0].liquidity == Liquidity::MAKER);
+      }}
+      .market_by_price({}, asks_3, UpdateType::INCREMENTAL);
+}
+
+TEST_CASE("algo_matcher_time_in_force_1", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(algo::matcher::Type::SIMPLE, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto canceled = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::CANCELED); };
+  auto post_only = Mask<ExecutionInstruction>{ExecutionInstruction::PARTICIPATE_DO_NOT_INITIATE};
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  auto bids_1 = std::array{create_mbp_update(100.0, 5.0)};
+  auto asks_1 = std::array{create_mbp_update(102.0, 1.0), create_mbp_update(102.5, 2.0)};
+  Helper{state}.market_by_price(bids_1, asks_1, UpdateType::SNAPSHOT);
+  // t=3
+  // note! IOC => remaining quantity is canceled
+  Helper{
+      state,
+      accepted,
+      [&](auto &order_update) {
+        CHECK(order_update.order_status == OrderStatus::CANCELED);
+        CHECK(order_update.traded_quantity == 1.0_a);
+        CHECK(order_update.remaining_quantity == 1.0_a);
+      },
+      [&](auto &trade_update) { REQUIRE(std::size(trade_update.fills) == 1); }}
+      .create_order(Side::BUY, OrderType::LIMIT, TimeInForce::IOC, 2.0, 102.0);
+  // t=4
+  // note! IOC not crossing => canceled (no fills)
+  Helper{state, accepted, canceled, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::IOC, 1.0, 101.0);
+  // t=5
+  // note! FOK => not enough liquidity
+  Helper{state, accepted, canceled, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::FOK, 4.0, 102.5);
+  // t=6
+  // note! liquidity taken at t=3 is depleted
+  Helper{state, accepted, canceled, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::FOK, 3.0, 102.5);
+  Helper{
+      state,
+      accepted,
+      [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::COMPLETED); },
+      [&](auto &trade_update) {
+        REQUIRE(std::size(trade_update.fills) == 1);
+        CHECK(trade_update.fills[0].price == 102.5_a);
+      }}
+      .create_order(Side::BUY, OrderType::LIMIT, TimeInForce::FOK, 2.0, 102.5);
+  // t=7
+  // note! post-only => crossing is rejected
+  Helper{state, [&](auto &order_ack) { CHECK(order_ack.error == Error::INVALID_PRICE); }, {}, {}}.create_order(
+      Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 102.0, post_only);
+  Helper{state, [&](auto &order_ack) { CHECK(order_ack.error == Error::INVALID_EXECUTION_INSTRUCTION); }, {}, {}}.create_order(
+      Side::BUY, OrderType::LIMIT, TimeInForce::IOC, 1.0, 101.0, post_only);
+  // t=8
+  Helper{state, accepted, [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); }, {}}.create_order(
+      Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 101.0, post_only);
+}
+
+TEST_CASE("algo_matcher_rescale_1", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(algo::matcher::Type::SIMPLE_PRICE_LADDER, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=2
+  Helper{state}.top_of_book(100.0, 1.0, 102.0, 1.0);
+  // t=3
+  auto order_id_1 = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.5);
+  // t=4
+  // note! finer tick size => resting orders are rescaled
+  Helper{state}.reference_data(0.05, 1.0);
+  // t=5
+  auto order_id_2 = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.55);
+  // t=6
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 2);
+        CHECK(sweep.order_updates[0].order_id == order_id_2);
+        CHECK(sweep.order_updates[0].average_traded_price == 100.55_a);
+        CHECK(sweep.order_updates[1].order_id == order_id_1);
+        CHECK(sweep.order_updates[1].average_traded_price == 100.5_a);
+      }}
+      .top_of_book(99.0, 1.0, 100.5, 1.0);
+}
+
+TEST_CASE("algo_matcher_rescale_2", "[algo_matcher]") {
+  auto type = GENERATE(algo::matcher::Type::SIMPLE, algo::matcher::Type::SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.05, 1.0);
+  // t=2
+  Helper{state}.top_of_book(99.0, 1.0, 101.0, 1.0);
+  // t=3
+  auto order_id_1 = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.05);
+  auto order_id_2 = Helper{state, accepted, working, {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.95);
+  // t=4
+  // note! not a divisor => internal prices are re-derived (buy 100.05 => 100.04, sell 100.95 => 100.96)
+  Helper{state}.reference_data(0.02, 1.0);
+  // t=5
+  Helper{state}.top_of_book(99.0, 1.0, 100.06, 1.0);
+  // t=6
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id_1);
+        CHECK(sweep.order_updates[0].average_traded_price == 100.05_a);
+      }}
+      .top_of_book(99.0, 1.0, 100.04, 1.0);
+  // t=7
+  Helper{state}.top_of_book(100.94, 1.0, 101.0, 1.0);
+  // t=8
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id_2);
+        CHECK(sweep.order_updates[0].average_traded_price == 100.95_a);
+      }}
+      .top_of_book(100.96, 1.0, 101.0, 1.0);
+}
+
+TEST_CASE("algo_matcher_rescale_3", "[algo_matcher]") {
+  auto type = GENERATE(
+      algo::matcher::Type::SIMPLE,
+      algo::matcher::Type::SIMPLE_PRICE_LADDER,
+      algo::matcher::Type::QUEUE_POSITION_SIMPLE,
+      algo::matcher::Type::QUEUE_POSITION_SIMPLE_PRICE_LADDER);
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto config = algo::matcher::Config{
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+      .market_data_source = algo::MarketDataSource::MARKET_BY_PRICE,
+  };
+  auto matcher = algo::matcher::Factory::create(type, dispatcher, order_cache, config);
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = *matcher,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto market_by_price = [&](auto bid_price, auto ask_price) {
+    auto bids = std::array{create_mbp_update(bid_price, 1.0)};
+    auto asks = std::array{create_mbp_update(ask_price, 1.0)};
+    return std::pair{bids, asks};
+  };
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  // ---
+  // t=1
+  Helper{state}.reference_data(0.01, 1.0);
+  // t=2
+  auto [bids_1, asks_1] = market_by_price(99.0, 101.0);
+  Helper{state}.market_by_price(bids_1, asks_1, UpdateType::SNAPSHOT);
+  // t=3
+  auto order_id_1 = Helper{state, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.05);
+  auto order_id_2 = Helper{state, accepted, working, {}}.create_order(Side::SELL, OrderType::LIMIT, TimeInForce::GTC, 1.0, 100.95);
+  // t=4
+  // note! loss of precision => internal prices are re-derived (buy 100.05 => 100.0, sell 100.95 => 101.0)
+  Helper{state}.reference_data(0.1, 1.0);
+  // t=5
+  auto [bids_2, asks_2] = market_by_price(99.0, 100.1);
+  Helper{state}.market_by_price(bids_2, asks_2, UpdateType::SNAPSHOT);
+  REQUIRE(state.order_cache.find(order_id_1, [&](auto &order) { CHECK(order.order_status == OrderStatus::WORKING); }));
+  // t=6
+  auto [bids_3, asks_3] = market_by_price(99.0, 100.0);
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id_1);
+        CHECK(sweep.order_updates[0].average_traded_price == 100.05_a);
+      }}
+      .market_by_price(bids_3, asks_3, UpdateType::SNAPSHOT);
+  // t=7
+  auto [bids_4, asks_4] = market_by_price(100.9, 101.5);
+  Helper{state}.market_by_price(bids_4, asks_4, UpdateType::SNAPSHOT);
+  REQUIRE(state.order_cache.find(order_id_2, [&](auto &order) { CHECK(order.order_status == OrderStatus::WORKING); }));
+  // t=8
+  auto [bids_5, asks_5] = market_by_price(101.0, 101.5);
+  Helper{
+      state,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id_2);
+        CHECK(sweep.order_updates[0].average_traded_price == 100.95_a);
+      }}
+      .market_by_price(bids_5, asks_5, UpdateType::SNAPSHOT);
+}
+
+TEST_CASE("algo_matcher_group_1", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto group = algo::matcher::Group{algo::matcher::Type::SIMPLE, dispatcher, order_cache, algo::MarketDataSource::TOP_OF_BOOK};
+  auto const SYMBOL_2 = "ETH-PERPETUAL"sv;
+  auto state_1 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto state_2 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL_2,
+      .next_order_id = 1000,  // note! shared order cache
+  };
+  // ---
+  // t=1
+  // note! dense ids are assigned when reference data is first seen
+  Helper{state_1}.reference_data(0.1, 1.0);
+  Helper{state_2}.reference_data(0.01, 1.0);
+  Helper{state_1}.reference_data(0.1, 1.0);
+  CHECK(std::size(group) == 2);
+  CHECK(group.find(0, EXCHANGE, SYMBOL) == 0);
+  CHECK(group.find(0, EXCHANGE, SYMBOL_2) == 1);
+  CHECK(group.find(0, EXCHANGE, "XYZ"sv) == algo::matcher::Group::UNDEFINED_ID);
+  CHECK(group.find(1, EXCHANGE, SYMBOL) == algo::matcher::Group::UNDEFINED_ID);
+  // t=2
+  Helper{state_1}.top_of_book(100.0, 1.0, 102.0, 1.0);
+  Helper{state_2}.top_of_book(10.0, 1.0, 10.2, 1.0);
+  // t=3
+  auto accepted = [&](auto &order_ack) { CHECK(order_ack.request_status == RequestStatus::ACCEPTED); };
+  auto working = [&](auto &order_update) { CHECK(order_update.order_status == OrderStatus::WORKING); };
+  auto order_id_1 = Helper{state_1, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 101.0);
+  auto order_id_2 = Helper{state_2, accepted, working, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 10.1);
+  // t=4
+  // note! routed to the second instrument only
+  Helper{
+      state_2,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(sweep.order_updates[0].order_id == order_id_2);
+      }}
+      .top_of_book(9.9, 1.0, 10.0, 1.0);
+  REQUIRE(state_1.order_cache.find(order_id_1, [&](auto &order) { CHECK(order.order_status == OrderStatus::WORKING); }));
+  REQUIRE(state_2.order_cache.find(order_id_2, [&](auto &order) { CHECK(order.order_status == OrderStatus::COMPLETED); }));
+  // t=5
+  // note! unknown instrument => rejected
+  auto state_3 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = "XYZ"sv,
+      .next_order_id = 2000,  // note! shared order cache
+  };
+  auto rejected = [&](auto &order_ack) {
+    CHECK(order_ack.request_status == RequestStatus::REJECTED);
+    CHECK(order_ack.error == Error::INVALID_SYMBOL);
+  };
+  Helper{state_3, rejected, {}, {}}.create_order(Side::BUY, OrderType::LIMIT, TimeInForce::GTC, 1.0, 101.0);
+  Helper{state_3}.cancel_all_orders(
+      {},
+      [&](auto &cancel_all_orders_ack) {
+        CHECK(cancel_all_orders_ack.request_status == RequestStatus::REJECTED);
+        CHECK(cancel_all_orders_ack.error == Error::INVALID_SYMBOL);
+      },
+      {});
+  // t=6
+  // note! not bound to an instrument => exactly one (aggregated) ack
+  auto state_4 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = {},
+      .symbol = {},
+      .time = std::max(state_1.time, state_2.time),  // note! shared matchers
+  };
+  Helper{state_4}.cancel_all_orders(
+      {},
+      [&](auto &cancel_all_orders_ack) {
+        CHECK(cancel_all_orders_ack.request_status == RequestStatus::ACCEPTED);
+        CHECK(cancel_all_orders_ack.number_of_affected_orders == 1);
+      },
+      [&](auto &batch) {
+        REQUIRE(std::size(batch.order_updates) == 1);
+        CHECK(batch.order_updates[0].order_id == order_id_1);
+        CHECK(batch.order_updates[0].order_status == OrderStatus::CANCELED);
+      });
+  // t=7
+  Helper{state_4}.cancel_all_orders(
+      {},
+      [&](auto &cancel_all_orders_ack) {
+        CHECK(cancel_all_orders_ack.request_status == RequestStatus::ACCEPTED);
+        CHECK(cancel_all_orders_ack.number_of_affected_orders == 0);
+      },
+      {});
+}
+
+TEST_CASE("algo_matcher_group_2", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto group = algo::matcher::Group{algo::matcher::Type::SIMPLE, dispatcher, order_cache, algo::MarketDataSource::TOP_OF_BOOK};
+  auto state = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = {},
+      .symbol = {},
+  };
+  // ---
+  // t=1
+  // note! no matchers => still exactly one ack
+  Helper{state}.cancel_all_orders(
+      {},
+      [&](auto &cancel_all_orders_ack) {
+        CHECK(cancel_all_orders_ack.request_status == RequestStatus::ACCEPTED);
+        CHECK(cancel_all_orders_ack.number_of_affected_orders == 0);
+      },
+      {});
+}
+
+TEST_CASE("algo_matcher_group_3", "[algo_matcher]") {
+  Dispatcher dispatcher;
+  OrderCache order_cache;
+  auto group = algo::matcher::Group{algo::matcher::Type::SIMPLE, dispatcher, order_cache, algo::MarketDataSource::TOP_OF_BOOK};
+  auto const SYMBOL_2 = "ETH-PERPETUAL"sv;
+  auto state_1 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL,
+  };
+  auto state_2 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = SYMBOL_2,
+  };
+  auto state_3 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = {},
+      .symbol = {},
+  };
+  // note! shared matchers => time must not move backwards
+  auto sync = [&]() {
+    auto time = std::max({state_1.time, state_2.time, state_3.time});
+    state_1.time = state_2.time = state_3.time = time;
+  };
+  auto create_mbp_update = [](auto price, auto quantity) {
+    return MBPUpdate{
+        .price = price,
+        .quantity = quantity,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+  };
+  auto create_quote = [](std::string_view const &symbol, std::span<MBPUpdate const> const &bids) {
+    return Quote{
+        .exchange = EXCHANGE,
+        .symbol = symbol,
+        .bids = bids,
+        .asks = {},
+    };
+  };
+  size_t count = {};
+  // ---
+  // t=1
+  Helper{state_1}.reference_data(0.1, 1.0);
+  Helper{state_2}.reference_data(0.1, 1.0);
+  sync();
+  // t=2
+  Helper{state_1}.top_of_book(100.0, 1.0, 102.0, 1.0);
+  Helper{state_2}.top_of_book(10.0, 1.0, 10.2, 1.0);
+  sync();
+  // t=3
+  // note! many instruments => exactly one (aggregated) ack
+  auto bids_1 = std::array{create_mbp_update(101.0, 1.0)};
+  auto bids_2 = std::array{create_mbp_update(10.1, 1.0)};
+  auto quotes_1 = std::array{create_quote(SYMBOL, bids_1), create_quote(SYMBOL_2, bids_2)};
+  Helper{state_3}.mass_quote(quotes_1, [&](auto &mass_quote_ack) {
+    ++count;
+    CHECK(mass_quote_ack.request_status == RequestStatus::ACCEPTED);
+    CHECK(std::empty(mass_quote_ack.symbol));
+  });
+  CHECK(count == 1);
+  // t=4
+  // note! unknown instrument => rejected before any matcher is called (nothing is changed)
+  auto bids_3 = std::array{create_mbp_update(100.5, 1.0)};
+  auto quotes_2 = std::array{create_quote(SYMBOL, bids_3), create_quote("XYZ"sv, bids_3)};
+  Helper{state_3}.mass_quote(quotes_2, [&](auto &mass_quote_ack) {
+    ++count;
+    CHECK(mass_quote_ack.request_status == RequestStatus::REJECTED);
+    CHECK(mass_quote_ack.error == Error::INVALID_SYMBOL);
+  });
+  CHECK(count == 2);
+  sync();
+  // t=5
+  Helper{
+      state_1,
+      [&](auto &sweep) {
+        REQUIRE(std::size(sweep.order_updates) == 1);
+        CHECK(algo::matcher::Quotes::is_quote(sweep.order_updates[0].order_id));
+        CHECK(sweep.order_updates[0].price == 101.0_a);
+      }}
+      .top_of_book(100.0, 1.0, 101.0, 1.0);
+  sync();
+  // t=6
+  // note! atomic per instrument => the first error is reported
+  auto bids_4 = std::array{create_mbp_update(10.3, 1.0)};  // note! crossing
+  auto quotes_3 = std::array{create_quote(SYMBOL, bids_3), create_quote(SYMBOL_2, bids_4)};
+  Helper{state_3}.mass_quote(quotes_3, [&](auto &mass_quote_ack) {
+    ++count;
+    CHECK(mass_quote_ack.request_status == RequestStatus::REJECTED);
+    CHECK(mass_quote_ack.error == Error::INVALID_PRICE);
+  });
+  CHECK(count == 3);
+  // t=7
+  auto state_4 = State2{
+      .dispatcher = dispatcher,
+      .order_cache = order_cache,
+      .matcher = group,
+      .source_name = SOURCE_NAME,
+      .account = ACCOUNT,
+      .exchange = EXCHANGE,
+      .symbol = "XYZ"sv,
+      .time = state_3.time,
+  };
+  Helper{state_4}.cancel_quotes([&](auto &cancel_quotes_ack) {
+    ++count;
+    CHECK(cancel_quotes_ack.request_status == RequestStatus::REJECTED);
+    CHECK(cancel_quotes_ack.error == Error::INVALID_SYMBOL);
+  });
+  CHECK(count == 4);
+  // t=8
+  // note! not bound to an instrument => exactly one (aggregated) ack
+  state_3.time = state_4.time;
+  Helper{state_3}.cancel_quotes([&](auto &cancel_quotes_ack) {
+    ++count;
+    CHECK(cancel_quotes_ack.request_status == RequestStatus::ACCEPTED);
+  });
+  CHECK(count == 5);
+}
@@ -0,0 +1,300 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "roq/algo/matcher/quotes.hpp"
+
+#include "roq/algo/simulator/latency.hpp"
+#include "roq/algo/simulator/sweep.hpp"
+
+using namespace std::literals;
+
+using namespace Catch::literals;
+
+using namespace roq;
+
+// === CONSTANTS ===
+
+namespace {
+auto const SOURCE_NAME = "deribit"sv;
+auto const ACCOUNT = "A1"sv;
+auto const EXCHANGE = "deribit"sv;
+auto const SYMBOL = "BTC-PERPETUAL"sv;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! the strategy is owned by the pipeline => results must be stored elsewhere
+struct Result final {
+  std::vector<uint64_t> rejected;
+  size_t quote_fills = {};
+};
+
+// note! each variant will rest a buy order at a different price (never filled)
+struct Strategy final : public algo::Strategy {
+  Strategy(size_t index, algo::Strategy::Dispatcher &dispatcher, Result &result) : index_{index}, dispatcher_{dispatcher}, result_{result} {}
+
+  void operator()(Event<TopOfBook> const &) override {
+    if (++top_of_book_ > 1) {
+      return;
+    }
+    auto create_order = CreateOrder{
+        .account = ACCOUNT,
+        .order_id = 1,
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .side = Side::BUY,
+        .position_effect = {},
+        .margin_mode = {},
+        .quantity_type = {},
+        .max_show_quantity = NaN,
+        .order_type = OrderType::LIMIT,
+        .time_in_force = TimeInForce::GTC,
+        .execution_instructions = {},
+        .request_template = {},
+        .quantity = 1.0,
+        .price = 98.5 - 0.5 * static_cast<double>(index_),
+        .stop_price = NaN,
+        .leverage = NaN,
+        .routing_id = {},
+        .strategy_id = {},
+        .release_time_utc = {},
+    };
+    dispatcher_.send(create_order, 0);
+    dispatcher_.send(create_order, 0);  // note! duplicate
+    auto modify_order = ModifyOrder{
+        .account = ACCOUNT,
+        .order_id = 2,  // note! unknown
+        .request_template = {},
+        .quantity = 1.0,
+        .price = 98.0,
+        .routing_id = {},
+        .version = {},
+        .conditional_on_version = {},
+        .release_time_utc = {},
+    };
+    dispatcher_.send(modify_order, 0);
+    auto cancel_order = CancelOrder{
+        .account = ACCOUNT,
+        .order_id = 3,  // note! unknown
+        .request_template = {},
+        .routing_id = {},
+        .version = {},
+        .conditional_on_version = {},
+        .release_time_utc = {},
+    };
+    dispatcher_.send(cancel_order, 0);
+    auto bid = MBPUpdate{
+        .price = 99.5,
+        .quantity = 1.0,
+        .implied_quantity = NaN,
+        .number_of_orders = {},
+        .update_action = {},
+        .price_level = {},
+    };
+    auto quote = Quote{
+        .exchange = EXCHANGE,
+        .symbol = SYMBOL,
+        .bids = {&bid, 1},
+        .asks = {},
+    };
+    auto mass_quote = MassQuote{
+        .account = ACCOUNT,
+        .quote_id = {},
+        .quotes = {&quote, 1},
+        .strategy_id = {},
+    };
+    dispatcher_.send(mass_quote, 0);
+  }
+
+  void operator()(Event<OrderAck> const &event, cache::Order const &order) override {
+    auto &order_ack = event.value;
+    if (order_ack.request_status == RequestStatus::REJECTED) {
+      CHECK(order.order_id == order_ack.order_id);
+      result_.rejected.emplace_back(order_ack.order_id);
+    }
+  }
+
+  void operator()(Event<TradeUpdate> const &event, cache::Order const &order) override {
+    CHECK(order.order_id == event.value.order_id);
+    if (algo::matcher::Quotes::is_quote(order.order_id)) {
+      ++result_.quote_fills;
+    }
+  }
+
+ private:
+  size_t const index_;
+  algo::Strategy::Dispatcher &dispatcher_;
+  Result &result_;
+  size_t top_of_book_ = {};
+};
+
+struct Reporter final : public algo::Reporter {
+  std::span<std::string_view const> get_labels() const override { return {}; }
+
+  void dispatch(Handler &, std::string_view const &) const override {}
+
+  void print(algo::reporter::OutputType, std::string_view const &) const override {}
+  void write(std::string_view const &, algo::reporter::OutputType, std::string_view const &) const override {}
+
+  void operator()(Event<CreateOrder> const &) override { ++create_order; }
+  void operator()(Event<OrderAck> const &event) override {
+    if (event.value.request_status == RequestStatus::REJECTED) {
+      ++rejected;
+    }
+  }
+  void operator()(Event<TradeUpdate> const &) override { ++trade_update; }
+
+  size_t create_order = {};
+  size_t rejected = {};
+  size_t trade_update = {};
+};
+
+struct Source final : public algo::simulator::Sweep::Source {
+  explicit Source(bool crossing) : crossing_{crossing} {}
+
+  void operator()(algo::simulator::Sweep::Handler &handler) const override {
+    ++replays;
+    auto reference_data = ReferenceData{};
+    reference_data.exchange = EXCHANGE;
+    reference_data.symbol = SYMBOL;
+    reference_data.tick_size = 0.5;
+    reference_data.min_trade_vol = 1.0;
+    handler(Event{create_message_info(1s), reference_data});
+    auto top_of_book = TopOfBook{};
+    top_of_book.exchange = EXCHANGE;
+    top_of_book.symbol = SYMBOL;
+    top_of_book.layer = {
+        .bid_price = 98.0,
+        .bid_quantity = 1.0,
+        .ask_price = 101.0,
+        .ask_quantity = 1.0,
+    };
+    top_of_book.update_type = UpdateType::INCREMENTAL;
+    handler(Event{create_message_info(2s), top_of_book});
+    if (!crossing_) {
+      return;
+    }
+    // note! the quote (not the orders) is now crossing
+    top_of_book.layer.ask_price = 99.0;
+    handler(Event{create_message_info(3s), top_of_book});
+  }
+
+  static MessageInfo create_message_info(std::chrono::nanoseconds receive_time) {
+    return {
+        .source = {},
+        .source_name = SOURCE_NAME,
+        .source_session_id = {},
+        .source_seqno = {},
+        .receive_time_utc = receive_time,
+        .receive_time = receive_time,
+        .source_send_time = {},
+        .source_receive_time = {},
+        .origin_create_time = {},
+        .origin_create_time_utc = {},
+        .is_last = true,
+        .opaque = {},
+    };
+  }
+
+  mutable std::atomic<size_t> replays = {};
+
+ private:
+  bool const crossing_;
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("algo_simulator_sweep_1", "[algo_simulator]") {
+  auto config = algo::simulator::Sweep::Config{
+      .size = 3,
+      .threads = 2,
+      .matcher_type = algo::matcher::Type::SIMPLE,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+      .order_management_latency = {},
+  };
+  std::vector<Result> results(config.size);  // note! each index is only accessed by a single worker
+  auto create_strategy = [&](size_t index, algo::Strategy::Dispatcher &dispatcher, algo::OrderCache &) -> std::unique_ptr<algo::Strategy> {
+    return std::make_unique<Strategy>(index, dispatcher, results[index]);
+  };
+  auto create_reporter = [&](size_t) -> std::unique_ptr<algo::Reporter> { return std::make_unique<Reporter>(); };
+  algo::simulator::Sweep sweep{config, create_strategy, create_reporter};
+  CHECK(std::size(sweep) == config.size);
+  Source source{true};
+  sweep.run(source);
+  CHECK(source.replays == 2);  // note! once per batch (not per pipeline)
+  for (size_t i = 0; i < config.size; ++i) {
+    auto &reporter = static_cast<Reporter const &>(sweep.get_reporter(i));
+    CHECK(reporter.create_order == 2);
+    CHECK(reporter.rejected == 3);
+    CHECK(reporter.trade_update == 1);  // note! quote fill
+    CHECK(results[i].rejected == std::vector<uint64_t>{1, 2, 3});
+    CHECK(results[i].quote_fills == 1);
+  }
+}
+
+TEST_CASE("algo_simulator_sweep_2", "[algo_simulator]") {
+  // note! requests are still in-flight when the event stream ends
+  auto config = algo::simulator::Sweep::Config{
+      .size = 2,
+      .threads = 1,
+      .matcher_type = algo::matcher::Type::SIMPLE,
+      .market_data_source = algo::MarketDataSource::TOP_OF_BOOK,
+      .order_management_latency = {algo::simulator::Latency{.base = 10s}},
+  };
+  std::vector<Result> results(config.size);
+  auto create_strategy = [&](size_t index, algo::Strategy::Dispatcher &dispatcher, algo::OrderCache &) -> std::unique_ptr<algo::Strategy> {
+    return std::make_unique<Strategy>(index, dispatcher, results[index]);
+  };
+  auto create_reporter = [&](size_t) -> std::unique_ptr<algo::Reporter> { return std::make_unique<Reporter>(); };
+  algo::simulator::Sweep sweep{config, create_strategy, create_reporter};
+  Source source{false};
+  sweep.run(source);
+  CHECK(source.replays == 1);
+  for (size_t i = 0; i < config.size; ++i) {
+    auto &reporter = static_cast<Reporter const &>(sweep.get_reporter(i));
+    CHECK(reporter.create_order == 2);
+    CHECK(reporter.rejected == 3);
+    CHECK(reporter.trade_update == 0);
+    CHECK(results[i].rejected == std::vector<uint64_t>{1, 2, 3});
+  }
+}
+
+TEST_CASE("algo_simulator_latency_1", "[algo_simulator]") {
+  std::mt19937_64 random;
+  // note! sub-millisecond (colocated)
+  auto latency_1 = algo::simulator::Latency{
+      .base = 250us,
+  };
+  CHECK(latency_1.is_fixed());
+  CHECK(latency_1.sample(random) == 250us);
+  // note! fat tail => clamped
+  auto latency_2 = algo::simulator::Latency{
+      .base = 250us,
+      .jitter = 50us,
+      .tail_probability = 1.0,
+      .tail_scale = 1ms,
+      .tail_shape = algo::simulator::Latency::MIN_TAIL_SHAPE,
+      .tail_max = 10ms,
+  };
+  CHECK_FALSE(latency_2.is_fixed());
+  auto min = std::chrono::nanoseconds::max();
+  auto max = std::chrono::nanoseconds::min();
+  for (size_t i = 0; i < 10000; ++i) {
+    auto sample = latency_2.sample(random);
+    min = std::min(sample, min);
+    max = std::max(sample, max);
+  }
+  CHECK(min >= 250us + 1ms);
+  CHECK(max <= 250us + 50us + 10ms);
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <utility>
+#include <vector>
+
+#include "roq/algo/simulator/timing_wheel.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+
+TEST_CASE("algo_simulator_timing_wheel_1", "[algo_simulator]") {
+  algo::simulator::TimingWheel<int> timing_wheel;
+  std::vector<std::pair<std::chrono::nanoseconds, int>> result;
+  auto callback = [&](auto expiry, auto value) { result.emplace_back(expiry, value); };
+  // note! different levels (and same expiry => insertion order)
+  timing_wheel.push(3h, 5);
+  timing_wheel.push(300ns, 2);
+  timing_wheel.push(1ns, 1);
+  timing_wheel.push(70us, 3);
+  timing_wheel.push(300ns, 4);
+  CHECK(std::size(timing_wheel) == 5);
+  timing_wheel.advance(0ns, callback);
+  CHECK(std::empty(result));
+  timing_wheel.advance(300ns, callback);
+  REQUIRE(std::size(result) == 3);
+  CHECK(result[0] == std::pair{1ns, 1});
+  CHECK(result[1] == std::pair{300ns, 2});
+  CHECK(result[2] == std::pair{300ns, 4});
+  result.clear();
+  // note! in the past => current time
+  timing_wheel.push(10ns, 6);
+  timing_wheel.advance(1ms, callback);
+  REQUIRE(std::size(result) == 2);
+  CHECK(result[0] == std::pair{300ns, 6});
+  CHECK(result[1] == std::pair{std::chrono::nanoseconds{70us}, 3});
+  result.clear();
+  // note! callback may push (zero delay is dispatched by the same advance)
+  timing_wheel.advance(4h, [&](auto expiry, auto value) {
+    result.emplace_back(expiry, value);
+    if (value == 5) {
+      timing_wheel.push(expiry, 7);
+      timing_wheel.push(expiry + 1s, 8);
+    }
+  });
+  REQUIRE(std::size(result) == 3);
+  CHECK(result[0] == std::pair{std::chrono::nanoseconds{3h}, 5});
+  CHECK(result[1] == std::pair{std::chrono::nanoseconds{3h}, 7});
+  CHECK(result[2] == std::pair{std::chrono::nanoseconds{3h + 1s}, 8});
+  CHECK(std::empty(timing_wheel));
+}
+
+TEST_CASE("algo_simulator_timing_wheel_2", "[algo_simulator]") {
+  algo::simulator::TimingWheel<int> timing_wheel;
+  // note! pseudo-random expiries spanning many levels must be dispatched in order
+  uint64_t state = 1;
+  auto next = [&]() {
+    state = state * 6364136223846793005 + 1442695040888963407;
+    return std::chrono::nanoseconds{static_cast<int64_t>(state >> (24 + (state % 24)))};
+  };
+  for (int i = 0; i < 10000; ++i) {
+    timing_wheel.push(next(), i);
+  }
+  std::chrono::nanoseconds last = {};
+  size_t count = 0;
+  auto ordered = true;
+  for (std::chrono::nanoseconds now = 1ms; !std::empty(timing_wheel); now *= 2) {
+    timing_wheel.advance(now, [&](auto expiry, auto) {
+      ordered = ordered && expiry >= last && expiry <= now;
+      last = expiry;
+      ++count;
+    });
+  }
+  CHECK(ordered);
+  CHECK(count == 10000);
+}